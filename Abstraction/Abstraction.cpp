@@ -1,31 +1,12 @@
 #include <iostream>
+#include <numeric>
+#include <vector>
+#include "../include/oops/abstraction.hpp"
+#include "../include/oops/dispatch_profiler.hpp" // OOPS_DISPATCH (opt-in profiling)
 using namespace std;
-
-// Abstract Class
-class Shape {
-public:
-    // Pure Virtual Function
-    virtual void draw() = 0; 
-    
-    // Concrete method
-    void commonFunction() {
-        cout << "This is a shape." << endl;
-    }
-};
-
-class Circle : public Shape {
-public:
-    void draw() override {
-        cout << "Drawing Circle..." << endl;
-    }
-};
-
-class Rectangle : public Shape {
-public:
-    void draw() override {
-        cout << "Drawing Rectangle..." << endl;
-    }
-};
+using oops::Circle;
+using oops::Rectangle;
+using oops::Shape;
 
 int main() {
     // Shape* s = new Shape(); // Error: Cannot instantiate abstract class
@@ -34,13 +15,33 @@ int main() {
     Shape* s2 = new Rectangle();
     
     s1->commonFunction();
-    s1->draw();
+    OOPS_DISPATCH(Shape, s1)->draw();
     
     s2->commonFunction();
-    s2->draw();
+    OOPS_DISPATCH(Shape, s2)->draw();
+    
+    Circle circle;
+    oops::drawCircle(circle);
+    
+    // Same call site, different concrete types (polymorphic site)
+    vector<Shape*> scene = {s1, s2, s1};
+    for (Shape* s : scene) {
+        OOPS_DISPATCH(Shape, s)->draw();
+    }
     
     delete s1;
     delete s2;
-    
+
+    // Bulk kernel on the thread pool: the area of every shape
+    vector<Rectangle> tiles(10000, Rectangle(2.0, 3.0));
+    vector<const Shape*> tileShapes;
+    for (const Rectangle& tile : tiles) tileShapes.push_back(&tile);
+    vector<double> areas(tileShapes.size());
+    oops::computeAreas(tileShapes, areas);
+    cout << "Total area (Expected 60000): " << accumulate(areas.begin(), areas.end(), 0.0) << endl;
+
+#ifdef OOPS_PROFILE_DISPATCH
+    oops::DispatchProfiler::instance().report(cout);
+#endif
     return 0;
 }
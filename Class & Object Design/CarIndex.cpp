@@ -0,0 +1,88 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../include/oops/car_index.hpp"
+using namespace std;
+
+/**
+ * Finding Cars: Indexes vs Scans
+ *
+ * 10M cars in an IndexedCarStore. Each query is answered twice: through
+ * the plan the store picks (index lookups where they pay off) and by a
+ * full scan, and the two answers are compared.
+ */
+
+template <typename Fn>
+double timeMs(Fn fn) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main() {
+    cout << "=== IndexedCarStore: Secondary Indexes ===" << endl;
+
+    const size_t count = 10'000'000;
+    const char* brands[] = {"Toyota", "Honda", "Ford", "Tesla", "BMW", "Audi", "Kia", "Fiat"};
+    vector<string> models;
+    for (int i = 0; i < 2000; ++i) {
+        models.push_back("Model " + to_string(i));
+    }
+
+    oops::IndexedCarStore inventory;
+    unsigned seed = 42;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const char* brand = i % 2048 == 5 ? "DeLorean" : brands[(seed >> 8) % 8]; // A rare brand
+        inventory.add(brand, models[(seed >> 11) % models.size()], int(1990 + (seed >> 22) % 35));
+    }
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Cars: " << count << ", built in " << buildMs << " ms" << endl;
+    cout << "Store: " << inventory.store().memoryBytes() / (1024 * 1024) << " MB, indexes: "
+         << inventory.indexBytes() / (1024 * 1024) << " MB" << endl;
+
+    // Incremental maintenance: erase every 10th car
+    start = chrono::steady_clock::now();
+    for (size_t row = 0; row < count; row += 10) {
+        inventory.erase(row);
+    }
+    double eraseMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Erased " << count / 10 << " cars in " << eraseMs << " ms; " << inventory.size() << " left" << endl;
+
+    struct Named {
+        const char* label;
+        oops::CarQuery query;
+    };
+    vector<Named> queries(6);
+    queries[0].label = "model == Model 7";
+    queries[0].query.model = "Model 7";
+    queries[1].label = "brand == Tesla, model == Model 7";
+    queries[1].query.brand = "Tesla";
+    queries[1].query.model = "Model 7";
+    queries[2].label = "year == 2024";
+    queries[2].query.minYear = queries[2].query.maxYear = 2024;
+    queries[3].label = "brand == Tesla, year >= 2020";
+    queries[3].query.brand = "Tesla";
+    queries[3].query.minYear = 2020;
+    queries[4].label = "brand == DeLorean, model == Model 7";
+    queries[4].query.brand = "DeLorean";
+    queries[4].query.model = "Model 7";
+    queries[5].label = "brand == Lada";
+    queries[5].query.brand = "Lada";
+
+    for (const Named& q : queries) {
+        vector<uint32_t> planned, scanned;
+        double plannedMs = timeMs([&] { planned = inventory.find(q.query); });
+        double scanMs = timeMs([&] { scanned = inventory.scan(q.query); });
+        cout << "\n" << q.label << ": " << planned.size() << " cars" << (planned == scanned ? "" : " (MISMATCH)") << endl;
+        cout << "  plan: " << inventory.plan(q.query).describe() << endl;
+        cout << "  planned " << plannedMs << " ms, full scan " << scanMs << " ms" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../include/oops/car.hpp"
+#include "../include/oops/car_store.hpp"
+using namespace std;
+
+/**
+ * From Objects to Columns: CarStore
+ *
+ * The same inventory held two ways: a vector of Car objects (72 bytes each)
+ * and a CarStore (6 bytes each: dictionary-coded brand/model, 16-bit year).
+ * Filters and aggregations over the store are vectorised scans split
+ * across threads.
+ */
+
+template <typename Fn>
+double timeMs(Fn fn) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main() {
+    cout << "=== CarStore: Packed Columns ===" << endl;
+
+    const size_t count = 10'000'000;
+    const char* brands[] = {"Toyota", "Honda", "Ford", "Tesla", "BMW", "Audi", "Kia", "Fiat"};
+    vector<oops::Car> cars(count);
+    unsigned seed = 42;
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        cars[i].brand = brands[(seed >> 8) % 8];
+        cars[i].model = "Model " + to_string((seed >> 12) % 200);
+        cars[i].year = int(1990 + (seed >> 20) % 35);
+    }
+
+    oops::CarStore store;
+    store.append(cars);
+    oops::CarStore singleThread(1);
+    singleThread.append(cars);
+
+    cout << "Cars: " << count << endl;
+    cout << "vector<Car>: " << count * sizeof(oops::Car) / (1024 * 1024) << " MB (" << sizeof(oops::Car)
+         << " bytes/car)" << endl;
+    cout << "CarStore   : " << store.memoryBytes() / (1024 * 1024) << " MB (6 bytes/car, "
+         << store.brandCodes().size() << " brands, " << store.modelCodes().size() << " models)" << endl;
+
+    // 1. Filter: brand == Tesla and year >= 2020
+    oops::CarQuery recentTeslas;
+    recentTeslas.brand = "Tesla";
+    recentTeslas.minYear = 2020;
+    size_t objectMatches = 0, storeMatches = 0, singleMatches = 0;
+    double objectsMs = timeMs([&] {
+        objectMatches = 0;
+        for (const oops::Car& car : cars) objectMatches += car.brand == "Tesla" && car.year >= 2020;
+    });
+    double singleMs = timeMs([&] { singleMatches = singleThread.count(recentTeslas); });
+    double storeMs = timeMs([&] { storeMatches = store.count(recentTeslas); });
+
+    cout << "\nTeslas from 2020 on: " << storeMatches
+         << (objectMatches == storeMatches && singleMatches == storeMatches ? " (all agree)" : " (MISMATCH)") << endl;
+    cout << "  vector<Car> loop      : " << objectsMs << " ms" << endl;
+    cout << "  CarStore, 1 thread    : " << singleMs << " ms" << endl;
+    cout << "  CarStore, all threads : " << storeMs << " ms" << endl;
+
+    // 2. Aggregation: cars per brand and per (brand, year)
+    vector<size_t> perBrand;
+    oops::BrandYearCounts perBrandYear;
+    double brandMs = timeMs([&] { perBrand = store.countPerBrand(); });
+    double brandYearMs = timeMs([&] { perBrandYear = store.countPerBrandYear(); });
+
+    cout << "\nCars per brand (" << brandMs << " ms):" << endl;
+    for (uint16_t code = 0; code < perBrand.size(); ++code) {
+        cout << "  " << store.brandCodes().decode(code) << ": " << perBrand[code] << endl;
+    }
+    uint16_t tesla = *store.brandCodes().find("Tesla");
+    cout << "Cars per (brand, year) (" << brandYearMs << " ms): Tesla 2024 = "
+         << perBrandYear.count(tesla, 2024) << endl;
+
+    cout << "\nFirst car, loaded back: ";
+    store.load(0).displayInfo();
+    return 0;
+}
@@ -1,20 +1,10 @@
 #include <iostream>
 #include <string>
+#include "../include/oops/car.hpp"
 using namespace std;
 
-// Class Definition
-class Car {
-public:
-    // Attributes
-    string brand;
-    string model;
-    int year;
-
-    // Method
-    void displayInfo() {
-        cout << "Brand: " << brand << ", Model: " << model << ", Year: " << year << endl;
-    }
-};
+// Class Definition (include/oops/car.hpp)
+using oops::Car;
 
 int main() {
     // Creating an Object of Car
@@ -38,5 +28,9 @@ int main() {
     cout << "Car 2 Info:" << endl;
     myCar2.displayInfo();
 
+#ifdef OOPS_INSTANCE_STATS
+    oops::InstanceRegistry::instance().dump(cout);
+#endif
+
     return 0;
 }
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include "../include/oops/bank_account.hpp"
+#include "../include/oops/car.hpp"
+#include "../include/oops/record_file.hpp"
+#include "../include/oops/student.hpp"
+using namespace std;
+
+/**
+ * Saving Objects: Binary Records
+ *
+ * Each class describes its fields once (oops::Schema<T>, next to the class).
+ * An array of objects is then written with a single write and read back by
+ * memory-mapping the file: fields are read in place, and an object is only
+ * built when load(i) is called.
+ */
+
+// An older version of Car, before `year` was added
+struct CarV0 {
+    string brand;
+    string model;
+};
+
+template <>
+struct oops::Schema<CarV0> {
+    static constexpr string_view name = "Car";
+    static constexpr uint32_t version = 0;
+    static constexpr auto fields() {
+        return make_tuple(member("brand", &CarV0::brand), member("model", &CarV0::model));
+    }
+};
+
+int main() {
+    cout << "=== Binary Records ===" << endl;
+
+    // 1. Write and read back each class
+    vector<oops::Car> cars(3);
+    cars[0].brand = "Toyota"; cars[0].model = "Corolla"; cars[0].year = 2022;
+    cars[1].brand = "Honda";  cars[1].model = "Civic";   cars[1].year = 2023;
+    cars[2].brand = "Tesla";  cars[2].model = "Model 3"; cars[2].year = 2024;
+    oops::writeRecords<oops::Car>("cars.rec", cars);
+
+    oops::RecordFile<oops::Car> carFile("cars.rec");
+    cout << "cars.rec: " << carFile.size() << " records (version " << carFile.version() << ")" << endl;
+    for (size_t i = 0; i < carFile.size(); ++i) {
+        carFile.load(i).displayInfo();
+    }
+
+    vector<oops::Student> students(2);
+    students[0].setName("Alice"); students[0].setAge(20).value();
+    students[1].setName("Bob");   students[1].setAge(22).value();
+    oops::writeRecords<oops::Student>("students.rec", students);
+
+    oops::RecordFile<oops::Student> studentFile("students.rec");
+    auto studentNames = studentFile.column<string_view>("name"); // Views into the mapping
+    auto studentAges = studentFile.column<int32_t>("age");
+    for (size_t i = 0; i < studentFile.size(); ++i) {
+        cout << "Student: " << studentNames[i] << ", " << studentAges[i] << endl;
+    }
+
+    vector<oops::BankAccount> accounts = {oops::BankAccount("12345", "John Doe", 1000.0),
+                                          oops::BankAccount("67890", "Jane Smith", 5000.0)};
+    oops::writeRecords<oops::BankAccount>("accounts.rec", accounts);
+
+    oops::RecordFile<oops::BankAccount> accountFile("accounts.rec");
+    for (size_t i = 0; i < accountFile.size(); ++i) {
+        oops::BankAccount account = accountFile.load(i);
+        cout << "Account " << account.getAccountNumber() << " (" << account.getAccountHolderName()
+             << "): $" << account.getBalance() << endl;
+    }
+
+    // 2. Versioning: a file written before `year` existed still loads
+    vector<CarV0> oldCars = {{"Ford", "Model T"}};
+    oops::writeRecords<CarV0>("cars_v0.rec", oldCars);
+    oops::RecordFile<oops::Car> oldFile("cars_v0.rec");
+    cout << "\ncars_v0.rec (version " << oldFile.version() << "): ";
+    oldFile.load(0).displayInfo(); // year reads as 0
+
+    // 3. Benchmark: 1M cars
+    const size_t count = 1'000'000;
+    const char* brands[] = {"Toyota", "Honda", "Ford", "Tesla", "BMW"};
+    vector<oops::Car> fleet(count);
+    for (size_t i = 0; i < count; ++i) {
+        fleet[i].brand = brands[i % 5];
+        fleet[i].model = "Model " + to_string(i % 100);
+        fleet[i].year = int(1990 + i % 35);
+    }
+
+    auto start = chrono::steady_clock::now();
+    oops::writeRecords<oops::Car>("fleet.rec", fleet);
+    double writeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    oops::RecordFile<oops::Car> fleetFile("fleet.rec");
+    auto years = fleetFile.column<int32_t>("year");
+    auto fleetBrands = fleetFile.column<string_view>("brand");
+    long long yearSum = 0;
+    size_t teslas = 0;
+    for (size_t i = 0; i < fleetFile.size(); ++i) {
+        yearSum += years[i];
+        teslas += fleetBrands[i] == "Tesla";
+    }
+    double scanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<oops::Car> loaded;
+    loaded.reserve(fleetFile.size());
+    for (size_t i = 0; i < fleetFile.size(); ++i) {
+        loaded.push_back(fleetFile.load(i));
+    }
+    double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "\nRecords: " << count << " (average year " << double(yearSum) / double(count)
+         << ", " << teslas << " Teslas)" << endl;
+    cout << "Write (one write call)     : " << writeMs << " ms" << endl;
+    cout << "Open + scan two columns    : " << scanMs << " ms" << endl;
+    cout << "Load all into Car objects  : " << loadMs << " ms" << endl;
+
+    for (const char* file : {"cars.rec", "students.rec", "accounts.rec", "cars_v0.rec", "fleet.rec"}) {
+        remove(file);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "../include/oops/lock_order.hpp" // Lock-order checking
+
+using namespace std;
+using oops::LockOrderGraph;
+using oops::LockOrderViolation;
+using oops::OrderCheckedMutex;
+
+// One lock per account, as in the Deadlocks.md example
+struct Account {
+    OrderCheckedMutex<> mtx;
+    double balance;
+
+    Account(const char* name, double balance) : mtx(name), balance(balance) {}
+};
+
+// Locks `from`, then `to`: two opposite transfers can deadlock
+void transfer(Account& from, Account& to, double amount) {
+    lock_guard<OrderCheckedMutex<>> lockFrom(from.mtx);
+    lock_guard<OrderCheckedMutex<>> lockTo(to.mtx);
+    from.balance -= amount;
+    to.balance += amount;
+}
+
+// Locks both at once (std::lock's try-and-back-off): no order to get wrong
+void transferSafely(Account& from, Account& to, double amount) {
+    scoped_lock both(from.mtx, to.mtx);
+    from.balance -= amount;
+    to.balance += amount;
+}
+
+int main() {
+    cout << "--- C++ Deadlock Detection Demo ---" << endl;
+
+    LockOrderGraph::instance().onViolation([](const LockOrderViolation& v) {
+        cout << "Potential deadlock detected: " << v.describe() << endl;
+    });
+
+    // The two transfers run one after the other, so this run cannot
+    // deadlock; the opposite lock orders are reported anyway
+    Account alice("Alice's account", 100.0);
+    Account bob("Bob's account", 100.0);
+    thread t1([&] { transfer(alice, bob, 10.0); });
+    t1.join();
+    thread t2([&] { transfer(bob, alice, 5.0); });
+    t2.join();
+    cout << "Alice: " << alice.balance << ", Bob: " << bob.balance << endl;
+
+    // scoped_lock takes the second lock with try_lock, which cannot block
+    Account carol("Carol's account", 100.0);
+    Account dave("Dave's account", 100.0);
+    thread t3([&] { transferSafely(carol, dave, 10.0); });
+    thread t4([&] { transferSafely(dave, carol, 5.0); });
+    t3.join();
+    t4.join();
+    cout << "Carol: " << carol.balance << ", Dave: " << dave.balance << endl;
+
+    cout << "Lock-order violations (Expected 1): " << LockOrderGraph::instance().violations() << endl;
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include "../include/oops/pipeline.hpp" // Pipeline, the queues it is built on
+
+using namespace std;
+using oops::Pipeline;
+using oops::PipelineOptions;
+
+struct Order {
+    int id = 0;
+    int quantity = 0;
+    double price = 0.0;
+    double total = 0.0;
+};
+
+// source -> validate -> price (3 threads) -> tax -> sink, with the given options
+void runOrders(const char* label, PipelineOptions options) {
+    Pipeline<Order> pipeline(options);
+    pipeline.stage("validate", [](Order& o) { if (o.quantity <= 0) o.quantity = 1; })
+            .stage("price", [](Order& o) { o.total = o.quantity * o.price; }, 3)
+            .stage("tax", [](Order& o) { o.total *= 1.25; });
+
+    int next = 0;
+    double revenue = 0.0;
+    auto start = chrono::steady_clock::now();
+    size_t delivered = pipeline.run(
+        [&](Order& o) {
+            if (next == 10000) return false;
+            o = Order{++next, next % 5, 4.0, 0.0}; // Every 5th order has quantity 0
+            return true;
+        },
+        [&](Order& o) { revenue += o.total; });
+    auto ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << label << ": " << pipeline.describe() << endl;
+    cout << "  Orders delivered (Expected 10000): " << delivered << endl;
+    cout << "  Revenue (Expected 110000): " << revenue << " in " << ms << " ms" << endl;
+}
+
+int main() {
+    cout << "--- C++ Producer/Consumer Pipeline Demo ---" << endl;
+
+    // Same stages, three ways of linking them
+    runOrders("One order per hand-off", {.batch = 1, .capacity = 64, .lockFree = true});
+    runOrders("Batches of 64", {.batch = 64, .capacity = 64, .lockFree = true});
+    runOrders("Batches of 64, mutex queues", {.batch = 64, .capacity = 64, .lockFree = false});
+
+    // A stage that throws: the pipeline drains, then run() rethrows
+    Pipeline<int> failing;
+    failing.stage("check", [](int& n) { if (n == 42) throw runtime_error("bad item 42"); });
+    int n = 0;
+    try {
+        failing.run([&](int& item) { item = ++n; return n <= 100; }, [](int&) {});
+    } catch (const exception& e) {
+        cout << "Pipeline failed (Expected bad item 42): " << e.what() << endl;
+    }
+    return 0;
+}
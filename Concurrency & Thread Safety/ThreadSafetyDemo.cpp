@@ -1,102 +1,51 @@
 #include <iostream>
-#include <thread>
-#include <vector>
-#include <mutex> // For mutex
-#include <atomic> // For atomic
+#include "../include/oops/thread_safety.hpp" // The three counters
 
 using namespace std;
-
-// 1. Unsafe Counter (Race Condition)
-class UnsafeCounter {
-public:
-    int count = 0;
-    void increment() {
-        count++; // Read-Modify-Write is not atomic
-    }
-};
-
-// 2. Safe Counter using Mutex
-class SafeCounterOnlyMutex {
-public:
-    int count = 0;
-    mutex mtx;
-
-    void increment() {
-        // lock_guard automatically locks when created and unlocks when destroyed (RAII)
-        lock_guard<mutex> lock(mtx);
-        count++;
-    }
-};
-
-// 3. Safe Counter using Atomics
-class SafeCounterAtomic {
-public:
-    atomic<int> count{0};
-
-    void increment() {
-        count++; // Atomic operation
-    }
-};
-
-void runThreadsUnsafe(UnsafeCounter& counter) {
-    auto task = [&counter]() {
-        for (int i = 0; i < 1000; ++i) {
-            counter.increment();
-        }
-    };
-
-    thread t1(task);
-    thread t2(task);
-
-    t1.join();
-    t2.join();
-}
-
-void runThreadsSafe(SafeCounterOnlyMutex& counter) {
-    auto task = [&counter]() {
-        for (int i = 0; i < 1000; ++i) {
-            counter.increment();
-        }
-    };
-
-    thread t1(task);
-    thread t2(task);
-
-    t1.join();
-    t2.join();
-}
-
-void runThreadsAtomic(SafeCounterAtomic& counter) {
-    auto task = [&counter]() {
-        for (int i = 0; i < 1000; ++i) {
-            counter.increment();
-        }
-    };
-
-    thread t1(task);
-    thread t2(task);
-
-    t1.join();
-    t2.join();
+using oops::SafeCounterAtomic;
+using oops::SafeCounterOnlyMutex;
+using oops::UnsafeCounter;
+
+// A LockedCounter with the given lock, incremented from two pool tasks
+template <typename Lock>
+void runLocked(const char* name) {
+    oops::LockedCounter<Lock> counter;
+    oops::incrementFromTwoTasks(counter);
+    cout << "Safe Counter (" << name << ") Value (Expected 2000): " << counter.count << endl;
 }
 
 int main() {
     cout << "--- C++ Concurrency & Thread Safety Demo ---" << endl;
 
-    // Unsafe
+    // Unsafe (two real threads, so the race can show)
     UnsafeCounter unsafeObj;
-    runThreadsUnsafe(unsafeObj);
+    oops::runThreadsUnsafe(unsafeObj);
     cout << "Unsafe Counter Value (Expected 2000): " << unsafeObj.count << endl;
 
-    // Safe (Mutex)
+    // Safe (Mutex); the safe counters run on the thread pool
     SafeCounterOnlyMutex safeObj;
-    runThreadsSafe(safeObj);
+    oops::runThreadsSafe(safeObj);
     cout << "Safe Counter (Mutex) Value (Expected 2000): " << safeObj.count << endl;
 
     // Safe (Atomic)
     SafeCounterAtomic atomicObj;
-    runThreadsAtomic(atomicObj);
+    oops::runThreadsAtomic(atomicObj);
     cout << "Safe Counter (Atomic) Value (Expected 2000): " << atomicObj.count.load() << endl;
 
+    // Safe (other locks, see include/oops/locks.hpp)
+    runLocked<oops::TtasSpinLock>("TTAS spinlock");
+    runLocked<oops::TicketLock>("Ticket lock");
+    runLocked<oops::McsLock>("MCS lock");
+    runLocked<oops::AdaptiveMutex>("Adaptive mutex");
+
+    // Safe (for heavy contention)
+    oops::SafeCounterSharded shardedObj;
+    oops::incrementFromTwoTasks(shardedObj);
+    cout << "Safe Counter (Sharded) Value (Expected 2000): " << shardedObj.value() << endl;
+
+    oops::SafeCounterCombining combiningObj;
+    oops::incrementFromTwoTasks(combiningObj);
+    cout << "Safe Counter (Flat combining) Value (Expected 2000): " << combiningObj.value() << endl;
+
     return 0;
 }
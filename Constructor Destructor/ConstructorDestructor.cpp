@@ -1,54 +1,11 @@
 #include <iostream>
-#include <string>
-#include <vector>
+#include "../include/oops/resource.hpp"
+#ifdef OOPS_COUNT_ALLOCATIONS
+#include "../include/oops/allocation_counter.hpp" // Replaces operator new to count allocations
+#endif
 
 using namespace std;
-
-// Class demonstrating Constructors, Destructors, and RAII
-class Resource {
-private:
-    string name;
-    int* data; // Pointer to simulate dynamic resource management
-
-public:
-    // 1. Default Constructor
-    Resource() {
-        name = "Default Resource";
-        data = new int(0);
-        cout << "[Constructor] Default created: " << name << endl;
-    }
-
-    // 2. Parameterized Constructor
-    Resource(string n) {
-        name = n;
-        data = new int(0);
-        cout << "[Constructor] Created: " << name << endl;
-    }
-
-    // 3. Member Initializer List (Preferred in C++)
-    Resource(string n, int value) : name(n), data(new int(value)) {
-        cout << "[Constructor] Created with value: " << name << " (" << *data << ")" << endl;
-    }
-
-    // 4. Copy Constructor
-    // Essential when class manages raw pointers (Deep Copy)
-    Resource(const Resource& other) {
-        name = other.name + " (Copy)";
-        data = new int(*other.data); // Deep copy of data
-        cout << "[Copy Constructor] Copied from: " << other.name << endl;
-    }
-
-    // 5. Destructor
-    // Automatically called when object goes out of scope
-    ~Resource() {
-        cout << "[Destructor] Cleaning up: " << name << endl;
-        delete data; // Prevent memory leak
-    }
-
-    void use() const {
-        cout << "Using resource: " << name << " [Data: " << *data << "]" << endl;
-    }
-};
+using oops::Resource;
 
 void createScope() {
     cout << "\n--- Entering Scope ---" << endl;
@@ -72,6 +29,15 @@ int main() {
     Resource r3(r2);
     r3.use();
 
+    // Move: r4 takes over r3's int, r3 is left empty
+    Resource r4(move(r3));
+    r4.use();
+    r3.use();
+
+    // Assignment (copy-and-swap): r3 gets a deep copy of r2 again
+    r3 = r2;
+    r3.use();
+
     // RAII Demonstration
     createScope();
 
@@ -80,5 +46,19 @@ int main() {
     delete r1; // Destructor called
 
     cout << "\nEnd of Main" << endl;
+
+#ifdef OOPS_COUNT_ALLOCATIONS
+    // Every Resource also allocates its int, hence the +1
+    cout << "\n--- Allocations per constructor ---" << endl;
+    bool ok = true;
+    ok &= oops::expectAllocations("Resource(string) short", 1, [] { Resource r("Short"); });
+    ok &= oops::expectAllocations("Resource(string) long", 2, [] { Resource r("A Resource With A Long Name"); });
+    ok &= oops::expectAllocations("Resource(string, int) long", 2, [] { Resource r("A Resource With A Long Name", 7); });
+    if (!ok) return 1;
+#endif
+
+#ifdef OOPS_INSTANCE_STATS
+    oops::InstanceRegistry::instance().dump(cout);
+#endif
     return 0;
 }
@@ -1,38 +1,12 @@
 #include <iostream>
-#include <string>
+#include "../include/oops/student.hpp"
+#ifdef OOPS_COUNT_ALLOCATIONS
+#include "../include/oops/allocation_counter.hpp" // Replaces operator new to count allocations
+#endif
 using namespace std;
 
-class Student {
-private:
-    // Private attribute
-    string name;
-    int age;
-
-public:
-    // Setter for name
-    void setName(string n) {
-        name = n;
-    }
-
-    // Getter for name
-    string getName() {
-        return name;
-    }
-
-    // Setter for age with validation
-    void setAge(int a) {
-        if(a > 0) {
-            age = a;
-        } else {
-            cout << "Age cannot be negative or zero." << endl;
-        }
-    }
-
-    // Getter for age
-    int getAge() {
-        return age;
-    }
-};
+// Student (private data + validating setters) lives in include/oops/student.hpp
+using oops::Student;
 
 int main() {
     Student s;
@@ -40,12 +14,35 @@ int main() {
     // s.name = "John"; // Error: name is private
     
     s.setName("John Doe");
-    s.setAge(20);
+    s.setAge(20).value(); // A valid age; value() would throw if it were not
     
     cout << "Name: " << s.getName() << endl;
     cout << "Age: " << s.getAge() << endl;
     
-    s.setAge(-5); // Testing validation
+    // Testing validation: the setter reports the error, the caller decides what to do
+    if (auto result = s.setAge(-5); !result) {
+        cout << oops::errorMessage(result.error()) << endl;
+    }
+
+    // Many checks: count errors in a sink instead of handling each one
+    oops::ErrorSink errors;
+    for (int age : {21, 0, -3, 22}) {
+        errors.check(s.setAge(age));
+    }
+    cout << "Rejected " << errors.total() << " of 4 ages:" << endl;
+    errors.report(cout);
+
+#ifdef OOPS_COUNT_ALLOCATIONS
+    cout << "\n--- Allocations per setter ---" << endl;
+    bool ok = oops::expectAllocations("setName(string_view) known name", 0, [&s] {
+        s.setName("John Doe");
+    });
+    if (!ok) return 1;
+#endif
+
+#ifdef OOPS_INSTANCE_STATS
+    oops::InstanceRegistry::instance().dump(cout);
+#endif
     
     return 0;
 }
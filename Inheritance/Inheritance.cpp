@@ -1,21 +1,8 @@
 #include <iostream>
-#include <string>
+#include "../include/oops/inheritance.hpp" // Vehicle, Car
 
-// Base Class
-class Vehicle {
-public:
-    std::string brand = "Generic Vehicle";
-
-    void honk() {
-        std::cout << "Tuut, tuut!\n";
-    }
-};
-
-// Derived Class
-class Car : public Vehicle {
-public:
-    std::string modelName = "Mustang";
-};
+// Car also exists in oops::, hence the inheritance namespace
+using oops::inheritance::Car;
 
 int main() {
     Car myCar;
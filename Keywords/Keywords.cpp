@@ -1,30 +1,10 @@
 #include <iostream>
-#include <string>
+#include "../include/oops/keywords.hpp" // Example: this, const, static
+#ifdef OOPS_COUNT_ALLOCATIONS
+#include "../include/oops/allocation_counter.hpp" // Replaces operator new to count allocations
+#endif
 using namespace std;
-
-class Example {
-public:
-    string name;
-    static int count; // Static variable declaration
-
-    Example(string name) {
-        this->name = name; // 'this' is a pointer to the current object
-        count++;
-    }
-
-    // Const member function: cannot modify object state
-    void display() const {
-        cout << "Name: " << this->name << endl;
-        // name = "New Name"; // Error: Cannot modify in const function
-    }
-
-    static void showCount() {
-        cout << "Total Objects: " << count << endl;
-    }
-};
-
-// Initialize static variable
-int Example::count = 0;
+using oops::Example;
 
 int main() {
     Example e1("Object 1");
@@ -36,5 +16,24 @@ int main() {
     // Call static method
     Example::showCount();
 
+    {
+        Example temp("Temporary");
+        Example::showCount();
+    } // temp destroyed: alive count goes back down
+    Example::showCount();
+
+#ifdef OOPS_COUNT_ALLOCATIONS
+    cout << "\n--- Allocations per constructor ---" << endl;
+    Example first("An example with a name longer than SSO"); // Interns the name
+    bool ok = oops::expectAllocations("Example(string_view) known name", 0, [] {
+        Example again("An example with a name longer than SSO");
+    });
+    if (!ok) return 1;
+#endif
+
+#ifdef OOPS_INSTANCE_STATS
+    oops::InstanceRegistry::instance().dump(cout);
+#endif
+
     return 0;
 }
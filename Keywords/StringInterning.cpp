@@ -0,0 +1,94 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/oops/string_interner.hpp"
+using namespace std;
+
+/**
+ * Memory Footprint: std::string vs InternedString
+ *
+ * Example::name, Student::name and BankAccount::accountHolderName are stored
+ * as oops::InternedString. This program shows what that saves when a
+ * million records share a thousand distinct names.
+ */
+
+// Count every heap byte the program asks for
+static atomic<size_t> heapBytes{0};
+
+void* operator new(size_t size) {
+    heapBytes += size;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+vector<string> makeNamePool(int distinct) {
+    vector<string> pool;
+    for (int i = 0; i < distinct; ++i) {
+        // Longer than the small-string buffer, like real customer names
+        pool.push_back("Account Holder Number " + to_string(i) + " Smith-Jones");
+    }
+    return pool;
+}
+
+int main() {
+    cout << "=== String Interning: Memory Footprint ===" << endl;
+
+    const size_t records = 1'000'000;
+    const vector<string> pool = makeNamePool(1000);
+
+    // 1. One std::string per record
+    size_t before = heapBytes;
+    vector<string> plain;
+    plain.reserve(records);
+    for (size_t i = 0; i < records; ++i) {
+        plain.push_back(pool[i % pool.size()]);
+    }
+    size_t plainBytes = heapBytes - before;
+
+    // 2. One 4-byte handle per record, one copy per distinct name
+    before = heapBytes;
+    vector<oops::InternedString> interned;
+    interned.reserve(records);
+    for (size_t i = 0; i < records; ++i) {
+        interned.emplace_back(pool[i % pool.size()]);
+    }
+    size_t internedBytes = heapBytes - before;
+
+    cout << "Records: " << records << ", distinct names: " << pool.size() << endl;
+    cout << "std::string      : " << plainBytes / 1024 << " KiB ("
+         << sizeof(string) << " bytes/handle + heap copy)" << endl;
+    cout << "InternedString   : " << internedBytes / 1024 << " KiB ("
+         << sizeof(oops::InternedString) << " bytes/handle, interner owns "
+         << oops::StringInterner::global().memoryBytes() / 1024 << " KiB)" << endl;
+    cout << "Same text: " << (plain[12345] == interned[12345].view() ? "yes" : "no") << endl;
+
+    // 3. Lookups of names that are already interned never take the lock
+    cout << "\nThreads | lookups/sec (already interned)" << endl;
+    for (int threads : {1, 2, 4, 8}) {
+        const size_t perThread = 2'000'000;
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (size_t i = 0; i < perThread; ++i) {
+                    oops::InternedString s(pool[(i + t) % pool.size()]);
+                    if (s.id() == 0) abort(); // Keeps the lookup observable
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << threads << "\t| " << double(threads * perThread) / seconds << endl;
+    }
+    return 0;
+}
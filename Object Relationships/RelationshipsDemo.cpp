@@ -1,73 +1,16 @@
 #include <iostream>
-#include <string>
-#include <vector>
+#include "../include/oops/relationships.hpp"
+#ifdef OOPS_COUNT_ALLOCATIONS
+#include "../include/oops/allocation_counter.hpp" // Replaces operator new to count allocations
+#endif
 
 using namespace std;
-
-// 1. Association
-class Car {
-public:
-    string model;
-    Car(string m) : model(m) {}
-};
-
-class Driver {
-public:
-    string name;
-    Driver(string n) : name(n) {}
-
-    void drive(Car* car) { // Uses a pointer/reference to Car
-        cout << name << " is driving " << car->model << endl;
-    }
-};
-
-// 2. Aggregation (Weak ownership uses pointers)
-class Professor {
-public:
-    string name;
-    Professor(string n) : name(n) {}
-};
-
-class University {
-public:
-    string name;
-    vector<Professor*> professors; // Holds pointers. Does NOT own memory strictly.
-
-    University(string n) : name(n) {}
-
-    void addProfessor(Professor* p) {
-        professors.push_back(p);
-    }
-    // Destructor does NOT delete professors
-};
-
-// 3. Composition (Strong ownership)
-class Engine {
-public:
-    string type;
-    Engine(string t) : type(t) {
-        cout << "  [Engine created]" << endl;
-    }
-    ~Engine() {
-        cout << "  [Engine destroyed]" << endl;
-    }
-};
-
-class Airplane {
-private:
-    Engine* engine; // Composition via pointer for explicit control, or object member
-public:
-    Airplane() {
-        cout << "Airplane created." << endl;
-        engine = new Engine("Jet Engine");
-    }
-
-    ~Airplane() {
-        // Airplane is responsible for destroying its parts
-        delete engine;
-        cout << "Airplane destroyed." << endl;
-    }
-};
+// Car also exists in oops::, hence the relationships namespace
+using oops::relationships::Airplane;
+using oops::relationships::Car;
+using oops::relationships::Driver;
+using oops::relationships::Professor;
+using oops::relationships::University;
 
 int main() {
     cout << "=== C++ Object Relationships Demo ===" << endl;
@@ -95,5 +38,17 @@ int main() {
         // Engine is created inside
     } // Plane destroyed, Engine destroyed automatically
 
+#ifdef OOPS_COUNT_ALLOCATIONS
+    cout << "\n--- Allocations per constructor ---" << endl;
+    bool ok = true;
+    ok &= oops::expectAllocations("Car(string) short", 0, [] { Car c("Mustang"); });
+    ok &= oops::expectAllocations("Car(string) long", 1, [] { Car c("Ford Mustang Shelby GT500 Convertible"); });
+    ok &= oops::expectAllocations("Driver(string) short", 0, [] { Driver d("Dave"); });
+    ok &= oops::expectAllocations("Driver(string) long", 1, [] { Driver d("Dr. Evelyn Montgomery-Richardson"); });
+    ok &= oops::expectAllocations("Professor(string) short", 0, [] { Professor p("Dr. Jones"); });
+    ok &= oops::expectAllocations("Professor(string) long", 1, [] { Professor p("Dr. Evelyn Montgomery-Richardson"); });
+    if (!ok) return 1;
+#endif
+
     return 0;
 }
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "../include/oops/calculator.hpp"
+using namespace std;
+using oops::addAtCompileTime;
+using oops::Array;
+using oops::Calculator;
+
+/**
+ * Compile-time Calculator and Expression Templates
+ *
+ * 1. constexpr / consteval: Calculator::add can run inside the compiler, so
+ *    constant inputs cost nothing at runtime (proved with static_assert).
+ * 2. Expression templates (array_expr.hpp): a + b + c + d over arrays is
+ *    evaluated in ONE loop when it is assigned to an Array.
+ */
+
+// Compile-time proof: none of these lines would compile if evaluated at runtime
+static_assert(Calculator{}.add(5, 10) == 15);
+static_assert(Calculator{}.add(5.5, 10.5) == 16.0);
+static_assert(addAtCompileTime(40, 2) == 42);
+
+constexpr int sumOfChain() {
+    Array<int> a{1, 2, 3}, b{10, 20, 30}, c{100, 200, 300}, d{1000, 2000, 3000};
+    Calculator calc;
+    Array<int> sum = calc.add(a + b, c + d);
+    return sum[0] + sum[1] + sum[2];
+}
+static_assert(sumOfChain() == 6666); // Expression templates work in constexpr too
+
+// 3. Benchmark: fused expression vs one temporary per '+'
+using Clock = chrono::steady_clock;
+
+template <typename T>
+vector<T> addEager(const vector<T>& a, const vector<T>& b) {
+    vector<T> out(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        out[i] = a[i] + b[i];
+    }
+    return out;
+}
+
+template <typename Body>
+double bestOf(size_t n, Body body) {
+    double best = numeric_limits<double>::max();
+    for (int run = 0; run < 5; ++run) {
+        auto start = Clock::now();
+        body();
+        best = min(best, chrono::duration<double, nano>(Clock::now() - start).count() / n);
+    }
+    return best;
+}
+
+void benchmark(size_t n) {
+    vector<double> va(n, 1.0), vb(n, 2.0), vc(n, 3.0), vd(n, 4.0), vr;
+    Array<double> a(n, 1.0), b(n, 2.0), c(n, 3.0), d(n, 4.0), r(n);
+
+    // Without expression templates: (a + b) -> tmp1, tmp1 + c -> tmp2, tmp2 + d -> result
+    double eager = bestOf(n, [&] { vr = addEager(addEager(addEager(va, vb), vc), vd); });
+    // With expression templates: one pass, no temporaries
+    double fused = bestOf(n, [&] { r = a + b + c + d; });
+
+    cout << n << "\t| " << eager << "\t\t| " << fused
+         << "\t(check: " << vr[n - 1] << " == " << r[n - 1] << ")" << endl;
+}
+
+int main() {
+    cout << "=== Compile-time Calculator & Expression Templates ===" << endl;
+
+    constexpr Calculator calc;
+    constexpr int sum = calc.add(5, 10); // Computed by the compiler
+    cout << "Sum (constexpr int): " << sum << endl;
+    cout << "Sum (consteval int): " << addAtCompileTime(40, 2) << endl;
+    cout << "Chained array sum (constexpr): " << sumOfChain() << endl;
+
+    Array<int> a{1, 2, 3}, b{4, 5, 6}, c{7, 8, 9}, d{10, 11, 12};
+    Array<int> total = a + b + c + d; // Single loop
+    cout << "a + b + c + d = " << total[0] << ", " << total[1] << ", " << total[2] << endl;
+
+    cout << "\nN\t| temporaries (ns/elem) | fused (ns/elem)" << endl;
+    for (size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 22}) {
+        benchmark(n);
+    }
+    return 0;
+}
@@ -1,44 +1,29 @@
 #include <iostream>
+#include "../include/oops/dispatch_profiler.hpp" // OOPS_DISPATCH (opt-in profiling)
+#include "../include/oops/polymorphism.hpp"
 using namespace std;
-
-class Calculator {
-public:
-    // 1. Compile-time Polymorphism (Function Overloading)
-    int add(int a, int b) {
-        return a + b;
-    }
-
-    double add(double a, double b) {
-        return a + b;
-    }
-};
-
-class Animal {
-public:
-    // Virtual function for Run-time Polymorphism
-    virtual void makeSound() {
-        cout << "Animal makes a sound" << endl;
-    }
-};
-
-class Dog : public Animal {
-public:
-    // 2. Run-time Polymorphism (Method Overriding)
-    void makeSound() override {
-        cout << "Dog barks" << endl;
-    }
-};
+using oops::Animal;
+using oops::Calculator;
+using oops::Dog;
 
 int main() {
-    // Test Overloading
+    // Test Overloading (compile-time polymorphism)
     Calculator calc;
     cout << "Sum (int): " << calc.add(5, 10) << endl;
     cout << "Sum (double): " << calc.add(5.5, 10.5) << endl;
 
-    // Test Overriding
+    // Test Overriding (run-time polymorphism)
     Animal* myAnimal = new Dog(); // Upcasting using pointer
-    myAnimal->makeSound(); // Calls Dog's method at runtime
+    OOPS_DISPATCH(Animal, myAnimal)->makeSound(); // Calls Dog's method at runtime
+
+    // Static type known: devirtualised
+    Dog dog;
+    oops::makeSoundDirect(dog);
 
     delete myAnimal; // Clean up memory
+
+#ifdef OOPS_PROFILE_DISPATCH
+    oops::DispatchProfiler::instance().report(cout);
+#endif
     return 0;
 }
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "../include/oops/calculator.hpp"
+using namespace std;
+using oops::Calculator;
+using oops::Overflow;
+
+/**
+ * Array Overloads for Calculator
+ *
+ * Polymorphism.cpp overloads Calculator::add for one pair of int/double at a
+ * time. The same overload set (calculator.hpp) also has span-based versions
+ * that add whole buffers in one call:
+ *
+ *     calc.add(a, b, out);   // out[i] = a[i] + b[i]
+ *
+ * This demo compares them with one call per element.
+ */
+
+// Benchmark: one call per element vs one call per buffer
+using Clock = chrono::steady_clock;
+
+// Best of several runs, in ns per element
+template <typename Body>
+double bestOf(size_t n, Body body) {
+    double best = numeric_limits<double>::max();
+    for (int run = 0; run < 5; ++run) {
+        auto start = Clock::now();
+        body();
+        best = min(best, chrono::duration<double, nano>(Clock::now() - start).count() / n);
+    }
+    return best;
+}
+
+template <typename T>
+void benchmark(const char* typeName, size_t n) {
+    Calculator calc;
+    vector<T> a(n), b(n), out(n);
+    iota(a.begin(), a.end(), T(0));
+    iota(b.begin(), b.end(), T(1));
+
+    double perElement = bestOf(n, [&] {
+        for (size_t i = 0; i < n; ++i) {
+            if constexpr (is_integral_v<T>) {
+                out[i] = T(calc.add(int(a[i]), int(b[i])));
+            } else {
+                out[i] = T(calc.add(double(a[i]), double(b[i])));
+            }
+        }
+    });
+    double perBuffer = bestOf(n, [&] { calc.add(a, b, out); });
+
+    cout << typeName << "\t" << n << "\t| " << perElement << "\t| " << perBuffer
+         << "\t(out[last] = " << out.back() << ")" << endl;
+}
+
+int main() {
+    cout << "=== Calculator: Array Overloads ===" << endl;
+    Calculator calc;
+
+    // Scalar overloads still work as before
+    cout << "Sum (int): " << calc.add(5, 10) << endl;
+    cout << "Sum (double): " << calc.add(5.5, 10.5) << endl;
+
+    // Whole-buffer overloads
+    vector<double> prices = {10.5, 20.25, 30.0};
+    vector<double> fees = {0.5, 0.75, 1.0};
+    vector<double> totals(3);
+    calc.add(prices, fees, totals);
+    cout << "Totals: " << totals[0] << ", " << totals[1] << ", " << totals[2] << endl;
+
+    // Integer overflow modes
+    vector<int32_t> big = {numeric_limits<int32_t>::max(), -5};
+    vector<int32_t> one = {1, 1};
+    vector<int32_t> result(2);
+
+    calc.add(big, one, result, Overflow::Saturate);
+    cout << "Saturate: " << result[0] << ", " << result[1] << endl;
+
+    calc.add(big, one, result, Overflow::Wrap);
+    cout << "Wrap: " << result[0] << ", " << result[1] << endl;
+
+    try {
+        calc.add(big, one, result); // Checked by default
+    } catch (const overflow_error& e) {
+        cout << "Checked: " << e.what() << endl;
+    }
+
+    cout << "\nType\tN\t| per-element (ns) | per-buffer (ns)" << endl;
+    for (size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 22}) {
+        benchmark<int32_t>("int32", n);
+        benchmark<int64_t>("int64", n);
+        benchmark<float>("float", n);
+        benchmark<double>("double", n);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Access Modifiers / Encapsulation: BankAccount transactions
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/bank_account.hpp"
+#include "oops/flat_combining.hpp"
+#include "oops/locks.hpp"
+
+namespace {
+
+constexpr std::size_t kAmounts = 4096; // Power of two: index with a mask
+
+// Amounts in (0, 1000], except 1 in 16 which is invalid (<= 0)
+std::vector<double> makeAmounts(std::uint64_t stream) {
+    std::mt19937_64 gen = oops::bench::rng(stream);
+    std::uniform_real_distribution<double> amount(0.01, 1000.0);
+    std::vector<double> amounts(kAmounts);
+    for (double& a : amounts) {
+        a = gen() % 16 == 0 ? -amount(gen) : amount(gen);
+    }
+    return amounts;
+}
+
+void BM_BankAccountDeposit(benchmark::State& state) {
+    oops::bench::QuietCout quiet; // deposit() logs every transaction
+    const std::vector<double> amounts = makeAmounts(1);
+    oops::BankAccount account("12345", "John Doe", 0.0);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(account.deposit(amounts[i++ % kAmounts]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BankAccountDeposit);
+
+// balance 0: every withdrawal is rejected (no logging);
+// a large balance: all valid withdrawals succeed and are logged
+void BM_BankAccountWithdraw(benchmark::State& state) {
+    oops::bench::QuietCout quiet;
+    const std::vector<double> amounts = makeAmounts(2);
+    oops::BankAccount account("12345", "John Doe", double(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(account.withdraw(amounts[i++ % kAmounts]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BankAccountWithdraw)->ArgName("balance")->Arg(0)->Arg(1'000'000'000'000);
+
+// A shared account that is mostly read: every thread calls getBalance(),
+// and deposits 1 time in range(0). Reader-writer locks let the reads overlap.
+template <typename Lock>
+void BM_GuardedAccountReadMostly(benchmark::State& state) {
+    using Account = oops::Guarded<oops::BankAccount, Lock>;
+    static std::unique_ptr<Account> account;
+    static std::unique_ptr<oops::bench::QuietCout> quiet; // Deposits log, under the lock
+    oops::bench::pinThread(unsigned(state.thread_index()));
+    if (state.thread_index() == 0) {
+        quiet = std::make_unique<oops::bench::QuietCout>();
+        account = std::make_unique<Account>("12345", "John Doe", 0.0);
+    }
+
+    const std::uint64_t writeEvery = std::uint64_t(state.range(0));
+    std::uint64_t i = std::uint64_t(state.thread_index());
+    for (auto _ : state) {
+        if (++i % writeEvery == 0) {
+            benchmark::DoNotOptimize(account->write([](oops::BankAccount& a) { return a.deposit(1.0); }));
+        } else {
+            benchmark::DoNotOptimize(account->read([](const oops::BankAccount& a) { return a.getBalance(); }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        account.reset();
+        quiet.reset();
+    }
+}
+BENCHMARK_TEMPLATE(BM_GuardedAccountReadMostly, std::mutex)
+    ->ArgName("write_every")->Arg(32)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_GuardedAccountReadMostly, std::shared_mutex)
+    ->ArgName("write_every")->Arg(32)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_GuardedAccountReadMostly, oops::TtasSpinLock)
+    ->ArgName("write_every")->Arg(32)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_GuardedAccountReadMostly, oops::RwSpinLock)
+    ->ArgName("write_every")->Arg(32)->ThreadRange(1, 8)->UseRealTime();
+
+oops::Result<> deposit(oops::Guarded<oops::BankAccount>& account, double amount) {
+    return account.write([amount](oops::BankAccount& a) { return a.deposit(amount); });
+}
+
+oops::Result<> deposit(oops::FlatCombining<oops::BankAccount>& account, double amount) {
+    return account.apply([amount](oops::BankAccount& a) { return a.deposit(amount); });
+}
+
+// Every thread deposits into one account: a mutex against flat combining
+template <typename Account>
+void BM_SharedAccountDeposit(benchmark::State& state) {
+    static std::unique_ptr<Account> account;
+    static std::unique_ptr<oops::bench::QuietCout> quiet; // Deposits log, one at a time
+    oops::bench::pinThread(unsigned(state.thread_index()));
+    if (state.thread_index() == 0) {
+        quiet = std::make_unique<oops::bench::QuietCout>();
+        account = std::make_unique<Account>("12345", "John Doe", 0.0);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(deposit(*account, 1.0));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        account.reset();
+        quiet.reset();
+    }
+}
+BENCHMARK_TEMPLATE(BM_SharedAccountDeposit, oops::Guarded<oops::BankAccount>)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedAccountDeposit, oops::FlatCombining<oops::BankAccount>)
+    ->ThreadRange(1, 128)
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,103 @@
+// Polymorphism: the Calculator::add overloads
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/calculator.hpp"
+
+namespace {
+
+constexpr std::size_t kInputs = 4096; // Power of two: index with a mask
+
+void BM_CalculatorAddInt(benchmark::State& state) {
+    auto gen = oops::bench::rng(4);
+    std::uniform_int_distribution<int> value(-1'000'000, 1'000'000);
+    std::vector<int> a(kInputs), b(kInputs);
+    for (std::size_t i = 0; i < kInputs; ++i) {
+        a[i] = value(gen);
+        b[i] = value(gen);
+    }
+    const oops::Calculator calc;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc.add(a[i % kInputs], b[i % kInputs]));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculatorAddInt);
+
+void BM_CalculatorAddDouble(benchmark::State& state) {
+    auto gen = oops::bench::rng(5);
+    std::uniform_real_distribution<double> value(-1e6, 1e6);
+    std::vector<double> a(kInputs), b(kInputs);
+    for (std::size_t i = 0; i < kInputs; ++i) {
+        a[i] = value(gen);
+        b[i] = value(gen);
+    }
+    const oops::Calculator calc;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc.add(a[i % kInputs], b[i % kInputs]));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculatorAddDouble);
+
+// Whole buffers: calc.add(a, b, out). Inputs never overflow, so the
+// integer modes all do the same work apart from their checks.
+template <typename T>
+void BM_CalculatorAddSpan(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    auto gen = oops::bench::rng(6);
+    std::vector<T> a(n), b(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = T(gen() % 1'000'000);
+        b[i] = T(gen() % 1'000'000);
+    }
+    const oops::Calculator calc;
+    for (auto _ : state) {
+        if constexpr (std::is_integral_v<T>) {
+            calc.add(a, b, out, oops::Overflow(state.range(1)));
+        } else {
+            calc.add(a, b, out);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+    state.SetBytesProcessed(state.iterations() * std::int64_t(3 * n * sizeof(T)));
+}
+
+// Overflow: 0 = Checked, 1 = Saturate, 2 = Wrap
+BENCHMARK_TEMPLATE(BM_CalculatorAddSpan, std::int32_t)
+    ->ArgNames({"n", "overflow"})
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0, 1, 2}});
+BENCHMARK_TEMPLATE(BM_CalculatorAddSpan, std::int64_t)
+    ->ArgNames({"n", "overflow"})
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {0}});
+BENCHMARK_TEMPLATE(BM_CalculatorAddSpan, float)->ArgName("n")->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_CalculatorAddSpan, double)->ArgName("n")->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// Expression templates: r = calc.add(a + b, c + d), one fused loop
+void BM_CalculatorAddExpr(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    oops::Array<double> a(n, 1.0), b(n, 2.0), c(n, 3.0), d(n, 4.0), r(n);
+    const oops::Calculator calc;
+    for (auto _ : state) {
+        r = calc.add(a + b, c + d);
+        benchmark::ClobberMemory();
+    }
+    benchmark::DoNotOptimize(r[n - 1]);
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+BENCHMARK(BM_CalculatorAddExpr)->ArgName("n")->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+} // namespace
@@ -0,0 +1,82 @@
+// Thread Safety: the three counters from ThreadSafetyDemo.cpp
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "harness.hpp"
+#include "oops/thread_safety.hpp"
+
+namespace {
+
+// One thread only: on several, UnsafeCounter is a data race
+void BM_UnsafeCounterIncrement(benchmark::State& state) {
+    oops::UnsafeCounter counter;
+    oops::bench::PerfRegion perf(state);
+    for (auto _ : state) {
+        counter.increment();
+        benchmark::DoNotOptimize(counter.count);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnsafeCounterIncrement);
+
+// All threads increment one shared counter: contention grows with threads
+template <typename Counter>
+void BM_SharedCounterIncrement(benchmark::State& state) {
+    static std::unique_ptr<Counter> counter;
+    oops::bench::pinThread(unsigned(state.thread_index()));
+    if (state.thread_index() == 0) counter = std::make_unique<Counter>();
+
+    oops::bench::PerfRegion perf(state);
+    // The loop starts and ends on a barrier across all threads
+    for (auto _ : state) {
+        counter->increment();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) counter.reset();
+}
+// Up to far more threads than CPUs: the mutex and the atomic against the
+// two counters built for heavy contention
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::SafeCounterOnlyMutex)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::SafeCounterAtomic)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::SafeCounterSharded)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::SafeCounterCombining)->ThreadRange(1, 128)->UseRealTime();
+// The same critical section behind the locks of locks.hpp
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::LockedCounter<oops::TtasSpinLock>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::LockedCounter<oops::TicketLock>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::LockedCounter<oops::McsLock>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::LockedCounter<oops::AdaptiveMutex>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCounterIncrement, oops::LockedCounter<oops::RwSpinLock>)->ThreadRange(1, 8)->UseRealTime();
+
+// The race demo's runner: start two std::threads, increment, join (thread
+// start-up included)
+template <typename Counter>
+void BM_IncrementFromTwoThreads(benchmark::State& state) {
+    const int perThread = int(state.range(0));
+    for (auto _ : state) {
+        Counter counter;
+        oops::incrementFromTwoThreads(counter, perThread);
+        benchmark::DoNotOptimize(&counter);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * perThread);
+}
+BENCHMARK_TEMPLATE(BM_IncrementFromTwoThreads, oops::SafeCounterOnlyMutex)->Arg(1000)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_IncrementFromTwoThreads, oops::SafeCounterAtomic)->Arg(1000)->UseRealTime();
+
+// The safe counters' runner: the same two loops as tasks on ThreadPool::global()
+template <typename Counter>
+void BM_IncrementFromTwoTasks(benchmark::State& state) {
+    const int perTask = int(state.range(0));
+    for (auto _ : state) {
+        Counter counter;
+        oops::incrementFromTwoTasks(counter, perTask);
+        benchmark::DoNotOptimize(&counter);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * perTask);
+}
+BENCHMARK_TEMPLATE(BM_IncrementFromTwoTasks, oops::SafeCounterOnlyMutex)->Arg(1000)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_IncrementFromTwoTasks, oops::SafeCounterAtomic)->Arg(1000)->UseRealTime();
+
+} // namespace
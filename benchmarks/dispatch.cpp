@@ -0,0 +1,76 @@
+// Abstraction / Polymorphism: virtual dispatch of Shape::draw and Animal::makeSound
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/abstraction.hpp"
+#include "oops/polymorphism.hpp"
+
+namespace {
+
+constexpr std::size_t kShapes = 1024;
+
+// range(0) = 0: every shape is a Circle (the call site stays monomorphic);
+// range(0) = 1: Circles and Rectangles in seeded random order
+void BM_ShapeDraw(benchmark::State& state) {
+    oops::bench::QuietCout quiet; // draw() prints
+    auto gen = oops::bench::rng(3);
+    std::vector<std::unique_ptr<oops::Shape>> shapes;
+    for (std::size_t i = 0; i < kShapes; ++i) {
+        if (state.range(0) == 1 && gen() % 2) {
+            shapes.push_back(std::make_unique<oops::Rectangle>());
+        } else {
+            shapes.push_back(std::make_unique<oops::Circle>());
+        }
+    }
+    oops::bench::PerfRegion perf(state);
+    for (auto _ : state) {
+        for (auto& shape : shapes) shape->draw();
+    }
+    state.SetItemsProcessed(state.iterations() * kShapes);
+}
+BENCHMARK(BM_ShapeDraw)->ArgName("mixed")->Arg(0)->Arg(1);
+
+// Static type Circle (final): direct call
+void BM_DrawCircleDirect(benchmark::State& state) {
+    oops::bench::QuietCout quiet;
+    oops::Circle circle;
+    oops::bench::PerfRegion perf(state);
+    for (auto _ : state) {
+        oops::drawCircle(circle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DrawCircleDirect);
+
+// Through Animal*: the vtable decides
+void BM_AnimalMakeSound(benchmark::State& state) {
+    oops::bench::QuietCout quiet;
+    std::unique_ptr<oops::Animal> animal = std::make_unique<oops::Dog>();
+    oops::Animal* target = animal.get();
+    oops::bench::PerfRegion perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(target); // Hide the dynamic type from the compiler
+        target->makeSound();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AnimalMakeSound);
+
+// Static type Dog (final): direct call
+void BM_MakeSoundDirect(benchmark::State& state) {
+    oops::bench::QuietCout quiet;
+    oops::Dog dog;
+    oops::bench::PerfRegion perf(state);
+    for (auto _ : state) {
+        oops::makeSoundDirect(dog);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MakeSoundDirect);
+
+} // namespace
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "oops/perf_scope.hpp"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * Shared pieces of the benchmark suite
+ *
+ * - Fixed seed: every benchmark that needs random input draws it from rng(),
+ *   seeded with settings().seed, so two runs (or two commits) measure the
+ *   same data.
+ * - CPU pinning: main() pins itself to one CPU and threaded benchmarks pin
+ *   thread i to the i-th CPU after it, so results do not depend on where the
+ *   scheduler happens to put the threads.
+ * - QuietCout: the demo classes print; benchmarks swallow that output so
+ *   they measure formatting, not the terminal.
+ * - PerfRegion: hardware counters (cycles, IPC, misses) per iteration, next
+ *   to the timings, wherever the machine provides them.
+ */
+
+namespace oops::bench {
+
+struct Settings {
+    std::uint64_t seed = 20240601; // --oops_seed=N
+    bool pin = true;               // --oops_pin=false
+    unsigned firstCpu = 0;         // --oops_first_cpu=N (index into the allowed CPUs)
+    bool perf = true;              // --oops_perf=false: no hardware counters
+};
+
+inline Settings& settings() {
+    static Settings s;
+    return s;
+}
+
+// A generator seeded with the run's seed plus a per-benchmark stream
+inline std::mt19937_64 rng(std::uint64_t stream = 0) {
+    return std::mt19937_64(settings().seed + stream);
+}
+
+// CPUs this process may run on, as captured before anything was pinned
+inline const std::vector<int>& allowedCpus() {
+    static const std::vector<int> cpus = [] {
+        std::vector<int> list;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) list.push_back(cpu);
+            }
+        }
+#endif
+        return list;
+    }();
+    return cpus;
+}
+
+// Pins the calling thread to the (firstCpu + index)-th allowed CPU.
+// Returns the CPU, or -1 if pinning is off or unsupported.
+inline int pinThread(unsigned index) {
+    const std::vector<int>& cpus = allowedCpus();
+    if (!settings().pin || cpus.empty()) return -1;
+    int cpu = cpus[(settings().firstCpu + index) % cpus.size()];
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) return -1; // 0 = calling thread
+    return cpu;
+#else
+    return -1;
+#endif
+}
+
+// Swallows everything written to std::cout while alive.
+// Creating and destroying it swaps cout's buffer, which races with any
+// other thread using cout. In a multi-threaded benchmark, let thread 0
+// alone create and destroy it, outside the timed loop, where no thread
+// writes to cout. Writes in the loop must be serialized by the caller
+// (e.g. made under the account's lock).
+class QuietCout {
+public:
+    QuietCout() : console(std::cout.rdbuf(&sink)) {}
+    ~QuietCout() { std::cout.rdbuf(console); }
+
+    QuietCout(const QuietCout&) = delete;
+    QuietCout& operator=(const QuietCout&) = delete;
+
+private:
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    NullBuffer sink;
+    std::streambuf* console;
+};
+
+// Each thread counts its own events; opened once per thread
+inline PerfCounters& threadPerfCounters() {
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+// Counts hardware events from construction to destruction and reports them
+// as per-iteration benchmark counters (summed over threads; IPC averaged).
+// Declare it right before the timed loop. Events the machine does not
+// provide are left out of the report.
+class PerfRegion {
+public:
+    explicit PerfRegion(benchmark::State& state) : state(state) {
+        if (settings().perf) begin = threadPerfCounters().start();
+    }
+
+    ~PerfRegion() {
+        if (!settings().perf) return;
+        PerfCounts counts = threadPerfCounters().stop(begin);
+        for (std::size_t i = 0; i < kPerfEvents; ++i) {
+            if (!counts.valid[i]) continue;
+            state.counters[std::string(perfEventName(PerfEvent(i)))] =
+                benchmark::Counter(double(counts.values[i]), benchmark::Counter::kAvgIterations);
+        }
+        if (counts.ipc() > 0) {
+            state.counters["IPC"] = benchmark::Counter(counts.ipc(), benchmark::Counter::kAvgThreads);
+        }
+    }
+
+    PerfRegion(const PerfRegion&) = delete;
+    PerfRegion& operator=(const PerfRegion&) = delete;
+
+private:
+    benchmark::State& state;
+    PerfMark begin;
+};
+
+} // namespace oops::bench
@@ -0,0 +1,41 @@
+// Lock-order checking: what OrderCheckedMutex adds to lock()/unlock()
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+#include "harness.hpp"
+#include "oops/lock_order.hpp"
+
+namespace {
+
+// One lock, nothing else held: no edge to record
+template <typename Mutex>
+void BM_LockUnlock(benchmark::State& state) {
+    Mutex mtx;
+    for (auto _ : state) {
+        std::lock_guard<Mutex> guard(mtx);
+        benchmark::DoNotOptimize(&mtx);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LockUnlock, std::mutex);
+BENCHMARK_TEMPLATE(BM_LockUnlock, oops::OrderCheckedMutex<>);
+
+// Two locks, always in the same order: the edge is already known to this
+// thread, so the shared graph is never touched after the first iteration
+template <typename Mutex>
+void BM_NestedLockUnlock(benchmark::State& state) {
+    Mutex outer;
+    Mutex inner;
+    for (auto _ : state) {
+        std::lock_guard<Mutex> first(outer);
+        std::lock_guard<Mutex> second(inner);
+        benchmark::DoNotOptimize(&inner);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_NestedLockUnlock, std::mutex);
+BENCHMARK_TEMPLATE(BM_NestedLockUnlock, oops::OrderCheckedMutex<>);
+
+} // namespace
@@ -0,0 +1,98 @@
+// Entry point of the benchmark suite: Google Benchmark's main, plus
+//
+//   --oops_seed=N        seed for all random inputs (default: fixed)
+//   --oops_pin=false     do not pin threads to CPUs
+//   --oops_first_cpu=N   first CPU to pin to (index into the allowed CPUs)
+//   --oops_perf=false    do not collect hardware counters (see PerfRegion)
+//
+// Results are also written as JSON to oops-benchmarks.json unless
+// --benchmark_out is given, so runs of two commits can be compared.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/thread_pool.hpp"
+
+namespace {
+
+// Consumes --oops_* flags, which Google Benchmark would reject as unknown
+bool parseFlag(const char* arg, oops::bench::Settings& s) {
+    auto value = [&](const char* name) -> const char* {
+        std::size_t n = std::strlen(name);
+        return std::strncmp(arg, name, n) == 0 ? arg + n : nullptr;
+    };
+    if (const char* v = value("--oops_seed=")) {
+        s.seed = std::stoull(v);
+    } else if (const char* v = value("--oops_pin=")) {
+        s.pin = std::strcmp(v, "false") != 0 && std::strcmp(v, "0") != 0;
+    } else if (const char* v = value("--oops_first_cpu=")) {
+        s.firstCpu = unsigned(std::stoul(v));
+    } else if (const char* v = value("--oops_perf=")) {
+        s.perf = std::strcmp(v, "false") != 0 && std::strcmp(v, "0") != 0;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Which hardware counters the benchmarks report, and why others are missing
+std::string perfContext(const oops::bench::Settings& s) {
+    if (!s.perf) return "off";
+    const oops::PerfCounters& counters = oops::bench::threadPerfCounters();
+    std::string events;
+    for (std::size_t i = 0; i < oops::kPerfEvents; ++i) {
+        if (!counters.available(oops::PerfEvent(i))) continue;
+        if (!events.empty()) events += ",";
+        events += oops::perfEventName(oops::PerfEvent(i));
+    }
+    if (events.empty()) events = "none";
+    if (!counters.reason().empty()) events += " (" + counters.reason() + ")";
+    return events;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    oops::bench::Settings& settings = oops::bench::settings();
+    std::vector<char*> args;
+    bool hasOut = false;
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0 && parseFlag(argv[i], settings)) continue;
+        hasOut |= std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+        args.push_back(argv[i]);
+    }
+    std::string out = "--benchmark_out=oops-benchmarks.json";
+    std::string format = "--benchmark_out_format=json";
+    if (!hasOut) {
+        args.push_back(out.data());
+        args.push_back(format.data());
+    }
+
+    oops::bench::allowedCpus(); // Capture the full set before pinning
+    // Start the pool's workers before pinning too: threads inherit their
+    // creator's CPU mask, and pinned workers would all share one core
+    oops::ThreadPool& pool = oops::ThreadPool::global();
+    int cpu = oops::bench::pinThread(0);
+
+    int count = int(args.size());
+    args.push_back(nullptr);
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+
+    // Recorded in the JSON "context", so a comparison can tell runs apart
+    benchmark::AddCustomContext("oops_seed", std::to_string(settings.seed));
+    benchmark::AddCustomContext("oops_pinned_cpu", cpu < 0 ? "none" : std::to_string(cpu));
+    benchmark::AddCustomContext("oops_pool_workers", std::to_string(pool.size()));
+    benchmark::AddCustomContext("oops_perf_counters", perfContext(settings));
+#ifdef OOPS_BUILD_TYPE
+    benchmark::AddCustomContext("oops_build_type", OOPS_BUILD_TYPE);
+#endif
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
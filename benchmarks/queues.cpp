@@ -0,0 +1,134 @@
+// Queues and the pipeline: lock-free rings against a mutex + condition_variable queue
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/pipeline.hpp"
+#include "oops/queues.hpp"
+
+namespace {
+
+using oops::BlockingQueue;
+using oops::BoundedMpmcQueue;
+using oops::SpscQueue;
+
+// Throughput: even threads push, odd threads pop, one item per iteration
+// each (every thread runs the same number of iterations, so the counts
+// match). Run with an even thread count.
+template <typename Queue>
+void BM_QueueTransfer(benchmark::State& state) {
+    static std::unique_ptr<Queue> queue;
+    oops::bench::pinThread(unsigned(state.thread_index()));
+    if (state.thread_index() == 0) queue = std::make_unique<Queue>(std::size_t(state.range(0)));
+    const bool producer = state.thread_index() % 2 == 0;
+    std::uint64_t item = 0;
+    for (auto _ : state) {
+        if (producer) {
+            queue->push(item++);
+        } else {
+            queue->pop(item);
+            benchmark::DoNotOptimize(item);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) queue.reset();
+}
+BENCHMARK_TEMPLATE(BM_QueueTransfer, SpscQueue<std::uint64_t>)
+    ->ArgName("capacity")->Arg(1024)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueTransfer, BoundedMpmcQueue<std::uint64_t>)
+    ->ArgName("capacity")->Arg(1024)->DenseThreadRange(2, 8, 2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueTransfer, BlockingQueue<std::uint64_t>)
+    ->ArgName("capacity")->Arg(1024)->DenseThreadRange(2, 8, 2)->UseRealTime();
+
+// Latency: one round trip to an echo thread and back, through two queues
+template <typename Queue>
+void BM_QueuePingPong(benchmark::State& state) {
+    Queue requests(64);
+    Queue replies(64);
+    std::thread echo([&] {
+        oops::bench::pinThread(1);
+        std::uint64_t item;
+        while (requests.pop(item)) replies.push(item);
+    });
+    std::uint64_t item = 0;
+    for (auto _ : state) {
+        requests.push(item);
+        replies.pop(item);
+        ++item;
+    }
+    requests.close();
+    echo.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_QueuePingPong, SpscQueue<std::uint64_t>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueuePingPong, BoundedMpmcQueue<std::uint64_t>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueuePingPong, BlockingQueue<std::uint64_t>)->UseRealTime();
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct Message {
+    std::int64_t createdNs = 0;
+    std::uint64_t value = 0;
+};
+
+// A few ns of work per stage that the compiler cannot drop
+void mix(Message& m) {
+    for (int i = 0; i < 8; ++i) {
+        m.value ^= m.value << 13;
+        m.value ^= m.value >> 7;
+        m.value ^= m.value << 17;
+    }
+}
+
+// End to end: range(0) stages (the middle one with two threads), items
+// handed over in batches of range(1), through lock-free (range(2) = 1) or
+// blocking links. Reports throughput, and the source-to-sink latency of
+// every 16th item: batching buys throughput with latency.
+void BM_Pipeline(benchmark::State& state) {
+    constexpr std::uint64_t items = 1 << 14;
+    const int stages = int(state.range(0));
+    oops::Pipeline<Message> pipeline({.batch = std::size_t(state.range(1)), .capacity = 64, .lockFree = state.range(2) != 0});
+    for (int s = 0; s < stages; ++s) pipeline.stage("mix", mix, s == stages / 2 ? 2 : 1);
+
+    std::vector<std::int64_t> latencies;
+    for (auto _ : state) {
+        std::uint64_t next = 0;
+        std::uint64_t checksum = 0;
+        pipeline.run(
+            [&](Message& m) {
+                if (next == items) return false;
+                m.value = ++next;
+                m.createdNs = nowNs();
+                return true;
+            },
+            [&](Message& m) {
+                checksum += m.value;
+                if ((m.value & 15) == 0) latencies.push_back(nowNs() - m.createdNs);
+            });
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(items));
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        state.counters["p50_us"] = double(latencies[latencies.size() / 2]) / 1e3;
+        state.counters["p99_us"] = double(latencies[latencies.size() * 99 / 100]) / 1e3;
+    }
+}
+BENCHMARK(BM_Pipeline)
+    ->ArgNames({"stages", "batch", "lock_free"})
+    ->ArgsProduct({{1, 3}, {1, 16, 256}, {1, 0}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,34 @@
+// Object Relationships: aggregation through University::addProfessor
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/relationships.hpp"
+
+namespace {
+
+using oops::relationships::Professor;
+using oops::relationships::University;
+
+// A new University gets range(0) professors (the vector grows as it goes)
+void BM_UniversityAddProfessor(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    std::vector<Professor> staff;
+    staff.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        staff.emplace_back("Professor " + std::to_string(i));
+    }
+    for (auto _ : state) {
+        University university("Tech University");
+        for (Professor& p : staff) university.addProfessor(&p);
+        benchmark::DoNotOptimize(university.professors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+BENCHMARK(BM_UniversityAddProfessor)->ArgName("professors")->RangeMultiplier(8)->Range(8, 4096);
+
+} // namespace
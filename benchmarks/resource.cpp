@@ -0,0 +1,64 @@
+// Constructor Destructor: Resource construction, copy and destruction
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include "harness.hpp"
+#include "oops/resource.hpp"
+
+namespace {
+
+// Objects per timed batch: construction and destruction are timed separately
+// and pausing the timer costs far more than one Resource
+constexpr std::size_t kBatch = 64;
+
+// range(0): length of the name (15 or less fits in the string's own buffer)
+std::string makeName(benchmark::State& state) {
+    return std::string(std::size_t(state.range(0)), 'r');
+}
+
+void BM_ResourceConstruct(benchmark::State& state) {
+    oops::bench::QuietCout quiet; // Constructors and destructor log
+    const std::string name = makeName(state);
+    std::array<std::optional<oops::Resource>, kBatch> slots;
+    for (auto _ : state) {
+        for (auto& slot : slots) slot.emplace(name);
+        state.PauseTiming();
+        for (auto& slot : slots) slot.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_ResourceConstruct)->ArgName("name")->Arg(8)->Arg(40);
+
+void BM_ResourceDestroy(benchmark::State& state) {
+    oops::bench::QuietCout quiet;
+    const std::string name = makeName(state);
+    std::array<std::optional<oops::Resource>, kBatch> slots;
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto& slot : slots) slot.emplace(name);
+        state.ResumeTiming();
+        for (auto& slot : slots) slot.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_ResourceDestroy)->ArgName("name")->Arg(8)->Arg(40);
+
+// Deep copy (new string and new int), then destruction of the copy
+void BM_ResourceCopy(benchmark::State& state) {
+    oops::bench::QuietCout quiet;
+    const oops::Resource original(makeName(state), 7);
+    for (auto _ : state) {
+        oops::Resource copy(original);
+        benchmark::DoNotOptimize(&copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResourceCopy)->ArgName("name")->Arg(8)->Arg(40);
+
+} // namespace
@@ -0,0 +1,140 @@
+// ThreadPool: task overhead and load balance of the bulk operations
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "harness.hpp"
+#include "oops/abstraction.hpp"
+#include "oops/bank_account.hpp"
+#include "oops/parallel.hpp"
+#include "oops/thread_pool.hpp"
+
+namespace {
+
+// Work of roughly `units` * a few ns that the compiler cannot drop
+std::uint64_t spin(std::uint64_t units, std::uint64_t seed) {
+    std::uint64_t x = seed | 1;
+    for (std::uint64_t i = 0; i < units; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+// range(0) tiny tasks through one TaskGroup: the per-task cost of
+// allocating, queueing, stealing and completing a job
+void BM_TaskGroupTinyTasks(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    oops::ThreadPool& pool = oops::ThreadPool::global();
+    std::atomic<std::uint64_t> sink{0};
+    for (auto _ : state) {
+        oops::TaskGroup group(pool);
+        for (std::size_t i = 0; i < n; ++i) {
+            group.run([&sink, i] { sink.fetch_add(spin(4, i), std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    benchmark::DoNotOptimize(sink.load());
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+    state.counters["workers"] = double(pool.size());
+}
+BENCHMARK(BM_TaskGroupTinyTasks)->ArgName("tasks")->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
+
+// Per-item cost that grows towards the end of the range: the last quarter
+// holds most of the work, as in a sorted or clustered input
+std::vector<std::uint32_t> skewedCosts(std::size_t n) {
+    std::vector<std::uint32_t> cost(n);
+    auto rng = oops::bench::rng(46);
+    for (std::size_t i = 0; i < n; ++i) {
+        cost[i] = 1 + std::uint32_t(rng() % 8) + (i >= n - n / 4 ? 400 : 0);
+    }
+    return cost;
+}
+
+// Static partitioning: one contiguous range per thread, fixed up front
+void BM_SkewedStaticRanges(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    const std::vector<std::uint32_t> cost = skewedCosts(n);
+    std::vector<std::uint64_t> out(n);
+    const std::size_t parts = oops::ThreadPool::global().size() + 1;
+    for (auto _ : state) {
+        oops::parallelRanges(n, parts, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) out[i] = spin(cost[i], i);
+        });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+BENCHMARK(BM_SkewedStaticRanges)->ArgName("items")->Arg(1 << 12)->Arg(1 << 16)->UseRealTime();
+
+// Lazy binary splitting: idle workers steal the unsplit halves, so the
+// expensive tail gets spread over all of them
+void BM_SkewedWorkStealing(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    const std::vector<std::uint32_t> cost = skewedCosts(n);
+    std::vector<std::uint64_t> out(n);
+    oops::ThreadPool& pool = oops::ThreadPool::global();
+    for (auto _ : state) {
+        pool.parallelFor(0, n, 16, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) out[i] = spin(cost[i], i);
+        });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+BENCHMARK(BM_SkewedWorkStealing)->ArgName("items")->Arg(1 << 12)->Arg(1 << 16)->UseRealTime();
+
+// Month-end interest over range(0) accounts; range(1) = 0 one account after
+// the other on this thread, 1 on the pool (oops::addMonthlyInterest)
+void BM_MonthlyInterest(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    std::vector<oops::SavingsAccount> accounts;
+    accounts.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) accounts.emplace_back(std::to_string(i), "Jane Smith", 1000.0, 1e-9);
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            for (oops::SavingsAccount& a : accounts) a.accrueMonthlyInterest();
+        } else {
+            oops::addMonthlyInterest(accounts);
+        }
+        benchmark::DoNotOptimize(accounts.data());
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+BENCHMARK(BM_MonthlyInterest)->ArgNames({"accounts", "pool"})->ArgsProduct({{1 << 12, 1 << 18}, {0, 1}})->UseRealTime();
+
+// Area of range(0) mixed shapes (one virtual call each); range(1) as above
+void BM_ComputeAreas(benchmark::State& state) {
+    const std::size_t n = std::size_t(state.range(0));
+    auto gen = oops::bench::rng(47);
+    std::vector<std::unique_ptr<oops::Shape>> owned;
+    std::vector<const oops::Shape*> shapes;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (gen() % 2) {
+            owned.push_back(std::make_unique<oops::Rectangle>(double(gen() % 100), double(gen() % 100)));
+        } else {
+            owned.push_back(std::make_unique<oops::Circle>(double(gen() % 100)));
+        }
+        shapes.push_back(owned.back().get());
+    }
+    std::vector<double> areas(n);
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            for (std::size_t i = 0; i < n; ++i) areas[i] = shapes[i]->area();
+        } else {
+            oops::computeAreas(shapes, areas);
+        }
+        benchmark::DoNotOptimize(areas.data());
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+BENCHMARK(BM_ComputeAreas)->ArgNames({"shapes", "pool"})->ArgsProduct({{1 << 12, 1 << 18}, {0, 1}})->UseRealTime();
+
+} // namespace
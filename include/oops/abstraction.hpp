@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+
+#include "thread_pool.hpp"
+
+namespace oops {
+
+// Abstract Class
+class Shape {
+public:
+    virtual ~Shape() = default;
+
+    // Pure Virtual Functions
+    virtual void draw() = 0;
+    virtual double area() const = 0;
+
+    // Concrete method
+    void commonFunction() {
+        std::cout << "This is a shape." << std::endl;
+    }
+};
+
+// Leaf classes are 'final' so calls through Circle& / Rectangle& are devirtualised
+class Circle final : public Shape {
+public:
+    explicit Circle(double radius = 1.0) : radius(radius) {}
+
+    void draw() override {
+        std::cout << "Drawing Circle..." << std::endl;
+    }
+
+    double area() const override { return std::numbers::pi * radius * radius; }
+
+private:
+    double radius;
+};
+
+class Rectangle final : public Shape {
+public:
+    explicit Rectangle(double width = 1.0, double height = 1.0) : width(width), height(height) {}
+
+    void draw() override {
+        std::cout << "Drawing Rectangle..." << std::endl;
+    }
+
+    double area() const override { return width * height; }
+
+private:
+    double width;
+    double height;
+};
+
+// Bulk kernel: out[i] = shapes[i]->area(), `grain` shapes per task on the
+// thread pool
+inline void computeAreas(std::span<const Shape* const> shapes, std::span<double> out,
+                         ThreadPool& pool = ThreadPool::global(), std::size_t grain = 4096) {
+    if (shapes.size() != out.size()) throw std::invalid_argument("computeAreas: one output per shape");
+    pool.parallelFor(0, shapes.size(), grain, [shapes, out](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) out[i] = shapes[i]->area();
+    });
+}
+
+// Hot path: static type is Circle (final) -> direct call to Circle::draw.
+// tools/check_devirtualization.sh verifies this in the generated code.
+inline void drawCircle(Circle& circle) {
+    circle.draw();
+}
+
+} // namespace oops
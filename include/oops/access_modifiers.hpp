@@ -0,0 +1,116 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+/**
+ * C++ Access Modifiers
+ *
+ * public, private and protected members, and what a derived class can see.
+ * BankAccount/SavingsAccount (bank_account.hpp) are the real-world example.
+ */
+
+namespace oops {
+
+// Public class demonstrating access modifiers
+class AccessModifiers {
+public:
+    // Public members - accessible from anywhere
+    std::string publicField;
+
+    // Public constructor
+    AccessModifiers() : publicField("Public field"),
+                       protectedField("Protected field"),
+                       privateField("Private field") {
+        std::cout << "AccessModifiers object created\n";
+    }
+
+    // Public method
+    void publicMethod() {
+        std::cout << "Public method called\n";
+        // Can access all members within the class
+        std::cout << "  " << publicField << "\n";
+        std::cout << "  " << privateField << "\n";
+        std::cout << "  " << protectedField << "\n";
+    }
+
+    // Public method that calls private method
+    void callPrivateMethod() {
+        privateMethod(); // OK - within same class
+    }
+
+protected:
+    // Protected members - accessible within class and derived classes
+    std::string protectedField;
+
+    void protectedMethod() {
+        std::cout << "Protected method called\n";
+    }
+
+private:
+    // Private members - accessible only within this class
+    std::string privateField;
+
+    void privateMethod() {
+        std::cout << "Private method called\n";
+    }
+};
+
+// Derived class to demonstrate protected access
+class DerivedClass : public AccessModifiers {
+public:
+    void testAccess() {
+        std::cout << "\n=== Derived Class Access ===\n";
+
+        // Can access public and protected members
+        std::cout << "Public field: " << publicField << "\n";        // OK
+        std::cout << "Protected field: " << protectedField << "\n";  // OK
+        // std::cout << privateField << "\n";                         // ERROR - private
+
+        publicMethod();      // OK
+        protectedMethod();   // OK
+        // privateMethod();  // ERROR - private
+    }
+};
+
+// Vehicle and Car are names other modules use too, hence the namespace
+namespace access {
+
+// Demonstration of inheritance and access control
+class Vehicle {
+public:
+    Vehicle(const std::string& m) : model(m) {
+        std::cout << "Vehicle created: " << model << "\n";
+    }
+
+    void start() {
+        std::cout << model << " starting...\n";
+    }
+
+protected:
+    std::string model;
+
+    void engineSound() {
+        std::cout << "Engine sound\n";
+    }
+
+private:
+    void internalDiagnostics() {
+        std::cout << "Running diagnostics...\n";
+    }
+};
+
+class Car : public Vehicle {
+public:
+    Car(const std::string& m) : Vehicle(m) {}
+
+    void accelerate() {
+        std::cout << model << " accelerating\n";  // Can access protected member
+        engineSound();                             // Can call protected method
+        // internalDiagnostics();                  // ERROR - private
+    }
+};
+
+} // namespace access
+
+} // namespace oops
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+/**
+ * Heap Allocation Counter
+ *
+ * Replaces the global operator new/delete to count allocations made by the
+ * current thread, so a demo can check how many allocations a constructor or
+ * setter really costs:
+ *
+ *     oops::expectAllocations("Car(string) short", 0, [] { Car c("Mustang"); });
+ *
+ * Replacement operators must be defined exactly once per program: include
+ * this header from the demo's main file only.
+ */
+
+namespace oops {
+
+inline thread_local std::size_t allocationCount = 0;
+
+template <typename Fn>
+std::size_t countAllocations(Fn&& fn) {
+    std::size_t before = allocationCount;
+    fn();
+    return allocationCount - before;
+}
+
+// Runs fn, prints the allocation count and returns whether it was <= maxAllowed
+template <typename Fn>
+bool expectAllocations(const char* what, std::size_t maxAllowed, Fn&& fn) {
+    std::size_t count = countAllocations(fn);
+    bool ok = count <= maxAllowed;
+    std::cout << "  " << what << ": " << count << " allocation(s), expected <= " << maxAllowed
+              << (ok ? "  [OK]" : "  [FAIL]") << std::endl;
+    return ok;
+}
+
+} // namespace oops
+
+// GCC flags free() on memory from operator new once it sees both bodies;
+// here that pairing is exactly what we want.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    ++oops::allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Expression Templates
+ *
+ * a + b + c + d over arrays builds a lightweight expression tree instead of
+ * three temporary arrays. The whole tree is evaluated in ONE loop when it is
+ * assigned to an Array. Everything is constexpr.
+ */
+
+namespace oops {
+
+// Every array-like expression derives from this tag
+struct ArrayExprTag {};
+
+template <typename E>
+concept ArrayExpr = std::derived_from<E, ArrayExprTag> && requires(const E& e, std::size_t i) {
+    e[i];
+    { e.size() } -> std::convertible_to<std::size_t>;
+};
+
+template <typename T>
+class Array;
+
+template <typename E>
+struct IsArray : std::false_type {};
+
+template <typename T>
+struct IsArray<Array<T>> : std::true_type {};
+
+// Arrays are held by reference (they outlive the expression), nested
+// expressions by value (they are temporaries of the full expression).
+template <typename E>
+using ExprStorage = std::conditional_t<IsArray<E>::value, const E&, E>;
+
+// Node for l[i] + r[i]. Nothing is computed until operator[] is called.
+template <ArrayExpr L, ArrayExpr R>
+class AddExpr : public ArrayExprTag {
+    ExprStorage<L> l;
+    ExprStorage<R> r;
+
+public:
+    constexpr AddExpr(const L& left, const R& right) : l(left), r(right) {
+        if (l.size() != r.size()) {
+            throw std::invalid_argument("AddExpr: arrays must have the same size");
+        }
+    }
+
+    constexpr auto operator[](std::size_t i) const { return l[i] + r[i]; }
+    constexpr std::size_t size() const { return l.size(); }
+};
+
+template <ArrayExpr L, ArrayExpr R>
+constexpr AddExpr<L, R> operator+(const L& l, const R& r) {
+    return AddExpr<L, R>(l, r);
+}
+
+// Owning array. Assigning an expression evaluates it element by element.
+template <typename T>
+class Array : public ArrayExprTag {
+    std::vector<T> data;
+
+public:
+    constexpr explicit Array(std::size_t n, T value = T{}) : data(n, value) {}
+    constexpr Array(std::initializer_list<T> values) : data(values) {}
+
+    template <ArrayExpr E>
+    constexpr Array(const E& expr) : data(expr.size()) {
+        *this = expr;
+    }
+
+    template <ArrayExpr E>
+    constexpr Array& operator=(const E& expr) {
+        if (expr.size() != data.size()) {
+            throw std::invalid_argument("Array: expression size does not match the array");
+        }
+        // The fused loop: a[i] + b[i] + c[i] + d[i], no intermediate buffers
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = expr[i];
+        }
+        return *this;
+    }
+
+    constexpr T operator[](std::size_t i) const { return data[i]; }
+    constexpr T& operator[](std::size_t i) { return data[i]; }
+    constexpr std::size_t size() const { return data.size(); }
+};
+
+} // namespace oops
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "instance_counted.hpp" // Tracked<T> (opt-in instance statistics)
+#include "record_schema.hpp"
+#include "result.hpp"
+#include "string_interner.hpp"
+#include "thread_pool.hpp"
+
+namespace oops {
+
+// Real-world example: BankAccount with proper encapsulation
+class BankAccount : public Tracked<BankAccount> {
+private:
+    // Private members - implementation details hidden
+    std::string accountNumber;
+    double balance;
+    InternedString accountHolderName; // Many accounts share a holder name
+
+    // Serialization may read and restore the private fields
+    template <typename> friend struct Schema;
+
+    // Private helper methods
+    static Result<> validateAmount(double amount) {
+        if (!(amount > 0)) {
+            return Unexpected(ErrorCode::InvalidAmount);
+        }
+        return {};
+    }
+
+    void logTransaction(const std::string& type, double amount) {
+        std::cout << type << ": $" << amount
+                  << " | New balance: $" << balance << "\n";
+    }
+
+protected:
+    // Protected methods - for derived classes
+    void applyInterest(double rate) {
+        double interest = accrueInterest(rate);
+        std::cout << "Interest applied: $" << interest << "\n";
+    }
+
+    // Adds the interest without logging it; returns it
+    double accrueInterest(double rate) {
+        double interest = balance * rate;
+        balance += interest;
+        return interest;
+    }
+
+public:
+    // Public constructor
+    BankAccount(std::string accNum, std::string_view name, double initialBalance)
+        : accountNumber(std::move(accNum)), balance(initialBalance), accountHolderName(name) {}
+
+    // Public methods - public API. A rejected transaction leaves the balance
+    // unchanged and says why in the returned Result.
+    Result<> deposit(double amount) {
+        if (Result<> valid = validateAmount(amount); !valid) {
+            return valid;
+        }
+        balance += amount;
+        logTransaction("Deposit", amount);
+        return {};
+    }
+
+    Result<> withdraw(double amount) {
+        if (Result<> valid = validateAmount(amount); !valid) {
+            return valid;
+        }
+        if (balance < amount) {
+            return Unexpected(ErrorCode::InsufficientFunds);
+        }
+        balance -= amount;
+        logTransaction("Withdrawal", amount);
+        return {};
+    }
+
+    // Public getters
+    double getBalance() const {
+        return balance;
+    }
+
+    std::string getAccountNumber() const {
+        return accountNumber;
+    }
+
+    std::string_view getAccountHolderName() const {
+        return accountHolderName;
+    }
+};
+
+// Derived class demonstrating protected access
+class SavingsAccount : public BankAccount {
+private:
+    double interestRate;
+
+public:
+    SavingsAccount(std::string accNum, std::string_view name, double initialBalance, double rate)
+        : BankAccount(std::move(accNum), name, initialBalance), interestRate(rate) {}
+
+    void addMonthlyInterest() {
+        // Can call protected method from parent
+        applyInterest(interestRate);
+    }
+
+    // addMonthlyInterest() without the log line, for bulk runs
+    double accrueMonthlyInterest() {
+        return accrueInterest(interestRate);
+    }
+};
+
+// Month-end run over many accounts: the interest is added on the thread
+// pool, `grain` accounts per task, without a log line per account. Each
+// account is updated by exactly one task.
+inline void addMonthlyInterest(std::span<SavingsAccount> accounts, ThreadPool& pool = ThreadPool::global(),
+                               std::size_t grain = 1024) {
+    pool.parallelFor(0, accounts.size(), grain, [accounts](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) accounts[i].accrueMonthlyInterest();
+    });
+}
+
+// Binary layout of BankAccount (see record_file.hpp)
+template <>
+struct Schema<BankAccount> {
+    static constexpr std::string_view name = "BankAccount";
+    static constexpr std::uint32_t version = 1;
+    static constexpr auto fields() {
+        return std::make_tuple(member("accountNumber", &BankAccount::accountNumber),
+                               member("accountHolderName", &BankAccount::accountHolderName),
+                               member("balance", &BankAccount::balance));
+    }
+    // No default constructor; load() fills in the fields afterwards
+    static BankAccount blank() { return BankAccount("", "", 0.0); }
+};
+
+} // namespace oops
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "array_expr.hpp"
+#include "parallel.hpp"
+
+/**
+ * Calculator - one overload set, three kinds of add
+ *
+ * 1. Scalars (compile-time polymorphism): constexpr, so constant inputs are
+ *    added by the compiler.
+ * 2. Whole buffers: calc.add(a, b, out) computes out[i] = a[i] + b[i] with
+ *    branch-free loops the compiler vectorises (SSE/AVX on x86, NEON on ARM).
+ *    Integer overloads take an Overflow mode; very large arrays are split
+ *    into cache-line aligned chunks processed on several threads.
+ * 3. Array expressions: calc.add(a + b, c) returns an expression template
+ *    (array_expr.hpp), evaluated in one loop when assigned to an Array.
+ */
+
+namespace oops {
+
+enum class Overflow {
+    Checked,  // Throw std::overflow_error if any element overflows
+    Saturate, // Clamp to numeric_limits<T>::min()/max()
+    Wrap      // Two's complement wrap-around
+};
+
+namespace kernels {
+
+template <typename T>
+void addFloating(const T* a, const T* b, T* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+// Elements the Checked kernel tests before writing any of them
+constexpr std::size_t kCheckBlock = 256;
+
+// Adds in unsigned arithmetic (well defined on wrap-around) and detects
+// overflow with the sign trick: the result has a different sign from both
+// operands. Returns the index of the first element that overflowed (Checked
+// mode only), or n.
+template <typename T>
+std::size_t addInteger(const T* a, const T* b, T* out, std::size_t n, Overflow mode) {
+    using U = std::make_unsigned_t<T>;
+    constexpr int signShift = std::numeric_limits<T>::digits;
+
+    switch (mode) {
+    case Overflow::Wrap:
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = T(U(a[i]) + U(b[i]));
+        }
+        return n;
+
+    case Overflow::Saturate:
+        for (std::size_t i = 0; i < n; ++i) {
+            T sum = T(U(a[i]) + U(b[i]));
+            bool overflow = ((a[i] ^ sum) & (b[i] ^ sum)) < 0;
+            // a < 0 -> min(), a >= 0 -> max()
+            T limit = T((a[i] >> signShift) ^ std::numeric_limits<T>::max());
+            out[i] = overflow ? limit : sum;
+        }
+        return n;
+
+    case Overflow::Checked:
+        // Tests a block, then writes it: the inputs of an overflowing block
+        // are still intact (even when out aliases a or b) to find the index
+        for (std::size_t start = 0; start < n; start += kCheckBlock) {
+            const std::size_t count = std::min(kCheckBlock, n - start);
+            const T* x = a + start;
+            const T* y = b + start;
+            T flags = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                T sum = T(U(x[i]) + U(y[i]));
+                flags |= (x[i] ^ sum) & (y[i] ^ sum);
+            }
+            if (flags < 0) {
+                // Slow path, only taken on error
+                for (std::size_t i = 0; i < count; ++i) {
+                    T sum = T(U(x[i]) + U(y[i]));
+                    if (((x[i] ^ sum) & (y[i] ^ sum)) < 0) return start + i;
+                }
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                out[start + i] = T(U(x[i]) + U(y[i]));
+            }
+        }
+        return n;
+    }
+    return n;
+}
+
+} // namespace kernels
+
+class Calculator {
+public:
+    // Arrays smaller than this are not worth the cost of starting threads
+    static constexpr std::size_t kParallelThreshold = std::size_t(1) << 20;
+
+    // 1. Scalar overloads: evaluated at compile time when inputs are constant
+    constexpr int add(int a, int b) const {
+        return a + b;
+    }
+
+    constexpr double add(double a, double b) const {
+        return a + b;
+    }
+
+    // 2. Array overloads: out[i] = a[i] + b[i]
+    // out may be the same buffer as a or b, but must not partially overlap.
+    // On overflow (Checked) the exception names the first overflowing index;
+    // out is then partially written: some elements hold their sums, the
+    // overflowing one and the rest of its block do not.
+    void add(std::span<const std::int32_t> a, std::span<const std::int32_t> b, std::span<std::int32_t> out,
+             Overflow mode = Overflow::Checked) const {
+        addIntegers(a, b, out, mode);
+    }
+
+    void add(std::span<const std::int64_t> a, std::span<const std::int64_t> b, std::span<std::int64_t> out,
+             Overflow mode = Overflow::Checked) const {
+        addIntegers(a, b, out, mode);
+    }
+
+    void add(std::span<const float> a, std::span<const float> b, std::span<float> out) const {
+        addFloating(a, b, out);
+    }
+
+    void add(std::span<const double> a, std::span<const double> b, std::span<double> out) const {
+        addFloating(a, b, out);
+    }
+
+    // 3. Expression overload: returns an expression, not a result
+    template <ArrayExpr L, ArrayExpr R>
+    constexpr auto add(const L& a, const R& b) const {
+        return a + b;
+    }
+
+private:
+    template <typename T>
+    static void checkSizes(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+        if (a.size() != b.size() || a.size() != out.size()) {
+            throw std::invalid_argument("Calculator::add: spans must have the same size");
+        }
+    }
+
+    // Runs kernel(begin, end) over [0, n), in parallel chunks for large n.
+    // kernel returns the first failing index in its range, or n; this
+    // returns the smallest of them.
+    template <typename T, typename Kernel>
+    static std::size_t forEachChunk(std::size_t n, Kernel kernel) {
+        const unsigned workers = defaultThreads();
+        if (n < kParallelThreshold || workers < 2) {
+            return kernel(std::size_t(0), n);
+        }
+        // Chunk boundaries on cache lines so threads never share one
+        std::vector<std::size_t> failed(workers, n);
+        parallelRanges(n, workers, 64 / sizeof(T), [&](std::size_t part, std::size_t begin, std::size_t end) {
+            failed[part] = kernel(begin, end);
+        });
+        return *std::min_element(failed.begin(), failed.end());
+    }
+
+    template <typename T>
+    static void addFloating(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+        checkSizes(a, b, out);
+        forEachChunk<T>(a.size(), [&](std::size_t begin, std::size_t end) {
+            kernels::addFloating(a.data() + begin, b.data() + begin, out.data() + begin, end - begin);
+            return a.size();
+        });
+    }
+
+    template <typename T>
+    static void addIntegers(std::span<const T> a, std::span<const T> b, std::span<T> out, Overflow mode) {
+        checkSizes(a, b, out);
+        const std::size_t n = a.size();
+        std::size_t first = forEachChunk<T>(n, [&](std::size_t begin, std::size_t end) {
+            std::size_t i = kernels::addInteger(a.data() + begin, b.data() + begin, out.data() + begin,
+                                                end - begin, mode);
+            return i == end - begin ? n : begin + i;
+        });
+        if (first != n) {
+            throw std::overflow_error("Calculator::add: integer overflow at index " + std::to_string(first));
+        }
+    }
+};
+
+// consteval: MUST be evaluated at compile time (error if inputs aren't constant)
+consteval int addAtCompileTime(int a, int b) {
+    return Calculator{}.add(a, b);
+}
+
+} // namespace oops
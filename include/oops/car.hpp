@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <tuple>
+
+#include "instance_counted.hpp" // Tracked<T> (opt-in instance statistics)
+#include "record_schema.hpp"
+
+namespace oops {
+
+// Class Definition (used by the Class & Object demos)
+class Car : public Tracked<Car> {
+public:
+    // Attributes
+    std::string brand;
+    std::string model;
+    int year = 0;
+
+    // Method
+    void displayInfo() const {
+        std::cout << "Brand: " << brand << ", Model: " << model << ", Year: " << year << std::endl;
+    }
+};
+
+// Binary layout of Car (see record_file.hpp)
+template <>
+struct Schema<Car> {
+    static constexpr std::string_view name = "Car";
+    static constexpr std::uint32_t version = 1;
+    static constexpr auto fields() {
+        return std::make_tuple(member("brand", &Car::brand),
+                               member("model", &Car::model),
+                               member("year", &Car::year));
+    }
+};
+
+} // namespace oops
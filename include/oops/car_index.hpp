@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "car.hpp"
+#include "car_store.hpp"
+
+/**
+ * IndexedCarStore - a CarStore plus secondary indexes
+ *
+ *   brand, model  hash index: dictionary code -> sorted list of rows
+ *                 (the Dictionary is the hash table, so the lookup is one probe)
+ *   year          bitmap index: one bitmap per distinct year
+ *
+ * Indexes are updated on every add()/erase(). Erased rows are dropped from
+ * the year bitmaps at once and from the row lists lazily (a list is
+ * compacted once more than half of it is dead), so erase() is amortised O(1).
+ *
+ * find() asks plan() for the cheapest way to answer a query: the smallest
+ * index, intersected with the other row list when both lists are of similar
+ * size, with the remaining conditions checked per row; or a vectorised scan
+ * of the whole store when the indexes would still return a large share of
+ * the cars.
+ */
+
+namespace oops {
+
+struct QueryPlan {
+    enum class Access { Empty, Scan, BrandIndex, ModelIndex, YearIndex };
+
+    Access access = Access::Scan;
+    std::size_t estimate = 0; // Rows the driving index yields (an upper bound)
+    bool intersect = false;   // Brand and model lists are intersected
+
+    std::string describe() const {
+        switch (access) {
+        case Access::Empty: return "empty (a value is not in the store)";
+        case Access::Scan: return "full scan (~" + std::to_string(estimate) + " rows)";
+        case Access::BrandIndex: return "brand index (" + std::to_string(estimate) + " rows)" +
+                                        (intersect ? " intersect model index" : "");
+        case Access::ModelIndex: return "model index (" + std::to_string(estimate) + " rows)" +
+                                        (intersect ? " intersect brand index" : "");
+        case Access::YearIndex: return "year bitmaps (" + std::to_string(estimate) + " rows)";
+        }
+        return "unknown";
+    }
+};
+
+class IndexedCarStore {
+public:
+    // An index is used when it returns at most 1/kScanRatio of the cars;
+    // past that, scanning 6-byte rows in order beats jumping between rows
+    static constexpr std::size_t kScanRatio = 32;
+    // Brand and model lists are intersected when the longer is at most this
+    // many times the shorter; otherwise checking each row's column is cheaper
+    static constexpr std::size_t kIntersectRatio = 16;
+
+    explicit IndexedCarStore(unsigned threads = defaultThreads()) : cars(threads) {}
+
+    std::size_t add(std::string_view brand, std::string_view model, int year) {
+        if (cars.size() > 0xFFFFFFFFu) throw std::length_error("IndexedCarStore: rows are 32-bit");
+        std::size_t row = cars.add(brand, model, year);
+        auto r = std::uint32_t(row);
+        indexAdd(brandIndex, cars.brandColumn()[row], r);
+        indexAdd(modelIndex, cars.modelColumn()[row], r);
+
+        YearBitmap& bitmap = yearIndex[std::uint16_t(year)];
+        if (bitmap.bits.size() <= row / 64) bitmap.bits.resize(row / 64 + 1, 0);
+        bitmap.bits[row / 64] |= std::uint64_t(1) << (row % 64);
+        ++bitmap.count;
+        return row;
+    }
+
+    std::size_t add(const Car& car) { return add(car.brand, car.model, car.year); }
+
+    bool erase(std::size_t row) {
+        if (!cars.erase(row)) return false;
+        indexErase(brandIndex[cars.brandColumn()[row]]);
+        indexErase(modelIndex[cars.modelColumn()[row]]);
+
+        YearBitmap& bitmap = yearIndex[cars.yearColumn()[row]];
+        bitmap.bits[row / 64] &= ~(std::uint64_t(1) << (row % 64));
+        --bitmap.count;
+        return true;
+    }
+
+    const CarStore& store() const { return cars; }
+    std::size_t size() const { return cars.liveCount(); }
+
+    // Bytes used by the indexes (not the store)
+    std::size_t indexBytes() const {
+        std::size_t bytes = 0;
+        for (const Postings& p : brandIndex) bytes += p.rows.capacity() * sizeof(std::uint32_t);
+        for (const Postings& p : modelIndex) bytes += p.rows.capacity() * sizeof(std::uint32_t);
+        for (const auto& [year, bitmap] : yearIndex) bytes += bitmap.bits.capacity() * 8;
+        return bytes;
+    }
+
+    QueryPlan plan(const CarQuery& query) const {
+        QueryPlan best;
+        best.estimate = cars.liveCount();
+        std::optional<std::uint16_t> brand, model;
+        if (!resolve(query, brand, model)) {
+            best.access = QueryPlan::Access::Empty;
+            best.estimate = 0;
+            return best;
+        }
+
+        auto consider = [&](QueryPlan::Access access, std::size_t estimate) {
+            if (estimate < best.estimate) {
+                best.access = access;
+                best.estimate = estimate;
+            }
+        };
+        if (brand) consider(QueryPlan::Access::BrandIndex, brandIndex[*brand].live);
+        if (model) consider(QueryPlan::Access::ModelIndex, modelIndex[*model].live);
+        if (query.minYear > 0 || query.maxYear < 0xFFFF) consider(QueryPlan::Access::YearIndex, yearCount(query));
+
+        if (best.access != QueryPlan::Access::Scan && best.estimate * kScanRatio > cars.liveCount()) {
+            best.access = QueryPlan::Access::Scan;
+            best.estimate = cars.liveCount();
+        }
+        if (brand && model && (best.access == QueryPlan::Access::BrandIndex ||
+                               best.access == QueryPlan::Access::ModelIndex)) {
+            std::size_t longer = std::max(brandIndex[*brand].live, modelIndex[*model].live);
+            best.intersect = longer <= best.estimate * kIntersectRatio;
+        }
+        return best;
+    }
+
+    // Rows of the matching live cars, ascending
+    std::vector<std::uint32_t> find(const CarQuery& query) const {
+        return run(query, plan(query));
+    }
+
+    std::size_t count(const CarQuery& query) const {
+        QueryPlan p = plan(query);
+        if (p.access == QueryPlan::Access::Scan) return cars.count(query);
+        return run(query, p).size();
+    }
+
+    // Ignores the indexes (for comparison)
+    std::vector<std::uint32_t> scan(const CarQuery& query) const {
+        QueryPlan p;
+        p.access = QueryPlan::Access::Scan;
+        return run(query, p);
+    }
+
+private:
+    struct Postings {
+        std::vector<std::uint32_t> rows; // Ascending; may include erased rows
+        std::size_t live = 0;
+    };
+
+    struct YearBitmap {
+        std::vector<std::uint64_t> bits; // Bit i: row i is live and has this year
+        std::size_t count = 0;
+    };
+    using YearIndex = std::map<std::uint16_t, YearBitmap>;
+
+    static void indexAdd(std::vector<Postings>& index, std::uint16_t code, std::uint32_t row) {
+        if (index.size() <= code) index.resize(code + 1);
+        index[code].rows.push_back(row); // Rows only grow, so the list stays sorted
+        ++index[code].live;
+    }
+
+    void indexErase(Postings& postings) {
+        --postings.live;
+        if (postings.rows.size() > 2 * postings.live + 64) {
+            std::erase_if(postings.rows, [&](std::uint32_t row) { return !cars.isLive(row); });
+        }
+    }
+
+    // Dictionary codes of the query's brand/model; false if one is unknown
+    bool resolve(const CarQuery& query, std::optional<std::uint16_t>& brand,
+                 std::optional<std::uint16_t>& model) const {
+        if (query.minYear > query.maxYear) return false;
+        if (query.brand) {
+            brand = cars.brandCodes().find(*query.brand);
+            if (!brand || *brand >= brandIndex.size()) return false;
+        }
+        if (query.model) {
+            model = cars.modelCodes().find(*query.model);
+            if (!model || *model >= modelIndex.size()) return false;
+        }
+        return true;
+    }
+
+    // Year-index entries inside the query's years, clamped to the 16-bit
+    // column the way CarStore::compile clamps them
+    std::pair<YearIndex::const_iterator, YearIndex::const_iterator> yearRange(const CarQuery& query) const {
+        const int lo = std::max(query.minYear, 0), hi = std::min(query.maxYear, 0xFFFF);
+        if (lo > hi) return {yearIndex.end(), yearIndex.end()};
+        return {yearIndex.lower_bound(std::uint16_t(lo)), yearIndex.upper_bound(std::uint16_t(hi))};
+    }
+
+    std::size_t yearCount(const CarQuery& query) const {
+        std::size_t n = 0;
+        for (auto [it, end] = yearRange(query); it != end; ++it) n += it->second.count;
+        return n;
+    }
+
+    bool matches(const CarQuery& query, std::optional<std::uint16_t> brand, std::optional<std::uint16_t> model,
+                 std::uint32_t row) const {
+        int year = cars.yearColumn()[row];
+        return cars.isLive(row) && (!brand || cars.brandColumn()[row] == *brand) &&
+               (!model || cars.modelColumn()[row] == *model) && year >= query.minYear && year <= query.maxYear;
+    }
+
+    // Rows in both ascending lists
+    static std::vector<std::uint32_t> intersect(const std::vector<std::uint32_t>& a,
+                                                const std::vector<std::uint32_t>& b) {
+        std::vector<std::uint32_t> out;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+        return out;
+    }
+
+    std::vector<std::uint32_t> run(const CarQuery& query, const QueryPlan& p) const {
+        std::vector<std::uint32_t> out;
+        std::optional<std::uint16_t> brand, model;
+        if (p.access == QueryPlan::Access::Empty || !resolve(query, brand, model)) return out;
+
+        switch (p.access) {
+        case QueryPlan::Access::Scan:
+            appendRows(cars.select(query), out);
+            break;
+        case QueryPlan::Access::BrandIndex:
+        case QueryPlan::Access::ModelIndex: {
+            bool byBrand = p.access == QueryPlan::Access::BrandIndex;
+            const auto& driver = byBrand ? brandIndex[*brand].rows : modelIndex[*model].rows;
+            if (p.intersect) {
+                const auto& other = byBrand ? modelIndex[*model].rows : brandIndex[*brand].rows;
+                out = intersect(driver, other);
+                std::erase_if(out, [&](std::uint32_t row) { return !matches(query, brand, model, row); });
+            } else {
+                for (std::uint32_t row : driver) {
+                    if (matches(query, brand, model, row)) out.push_back(row);
+                }
+            }
+            break;
+        }
+        case QueryPlan::Access::YearIndex: {
+            std::vector<std::uint64_t> bits((cars.size() + 63) / 64, 0);
+            for (auto [it, end] = yearRange(query); it != end; ++it) {
+                const auto& year = it->second.bits;
+                for (std::size_t w = 0; w < year.size(); ++w) bits[w] |= year[w];
+            }
+            appendRows(bits, out);
+            if (brand || model) {
+                std::erase_if(out, [&](std::uint32_t row) { return !matches(query, brand, model, row); });
+            }
+            break;
+        }
+        case QueryPlan::Access::Empty:
+            break;
+        }
+        return out;
+    }
+
+    static void appendRows(const std::vector<std::uint64_t>& bits, std::vector<std::uint32_t>& out) {
+        for (std::size_t w = 0; w < bits.size(); ++w) {
+            for (std::uint64_t word = bits[w]; word; word &= word - 1) {
+                out.push_back(std::uint32_t(w * 64 + std::countr_zero(word)));
+            }
+        }
+    }
+
+    CarStore cars;
+    std::vector<Postings> brandIndex; // By brand code
+    std::vector<Postings> modelIndex; // By model code
+    YearIndex yearIndex;
+};
+
+} // namespace oops
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "car.hpp"
+#include "parallel.hpp"
+
+/**
+ * CarStore - packed columns for millions of cars
+ *
+ * A Car object is two std::strings and an int (72 bytes). The store keeps one
+ * column per field instead, 6 bytes per car:
+ *
+ *   brand, model  16-bit codes into a Dictionary (each distinct string once)
+ *   year          16-bit
+ *
+ * Queries such as "brand == Tesla and year >= 2020" become one branch-free
+ * pass over the columns, 64 rows at a time, which the compiler vectorises;
+ * matches come back as a bitmap (1 bit per car). Counts and per-brand/year
+ * aggregations split the rows across threads. erase() only marks a row dead
+ * (row numbers stay stable); scans skip dead rows.
+ *
+ *     oops::CarStore store;
+ *     store.append(cars);
+ *     oops::CarQuery query;
+ *     query.brand = "Tesla";
+ *     query.minYear = 2020;
+ *     std::size_t n = store.count(query);
+ */
+
+namespace oops {
+
+// Distinct values of a string column, each with a dense 16-bit code
+class Dictionary {
+public:
+    Dictionary() = default;
+
+    // The keys of `codes` point into `values`: a copy rebuilds them against
+    // its own strings. Moving a deque keeps its elements in place, so the
+    // default moves keep the keys valid.
+    Dictionary(const Dictionary& other) : values(other.values) { rebuildCodes(); }
+
+    Dictionary& operator=(const Dictionary& other) {
+        if (this != &other) {
+            values = other.values;
+            rebuildCodes();
+        }
+        return *this;
+    }
+
+    Dictionary(Dictionary&&) = default;
+    Dictionary& operator=(Dictionary&&) = default;
+
+    // Code for `value`, adding it if new
+    std::uint16_t encode(std::string_view value) {
+        if (auto it = codes.find(value); it != codes.end()) return it->second;
+        if (values.size() > 0xFFFF) throw std::length_error("Dictionary: more than 65536 distinct values");
+        values.emplace_back(value);
+        std::uint16_t code = std::uint16_t(values.size() - 1);
+        codes.emplace(values.back(), code); // deque: the key's characters never move
+        return code;
+    }
+
+    std::optional<std::uint16_t> find(std::string_view value) const {
+        if (auto it = codes.find(value); it != codes.end()) return it->second;
+        return std::nullopt;
+    }
+
+    std::string_view decode(std::uint16_t code) const { return values[code]; }
+    std::size_t size() const { return values.size(); }
+
+private:
+    void rebuildCodes() {
+        codes.clear();
+        codes.reserve(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) codes.emplace(values[i], std::uint16_t(i));
+    }
+
+    std::unordered_map<std::string_view, std::uint16_t> codes;
+    std::deque<std::string> values;
+};
+
+// Conditions are ANDed; an unset brand/model matches every car
+struct CarQuery {
+    std::optional<std::string_view> brand;
+    std::optional<std::string_view> model;
+    int minYear = 0;
+    int maxYear = 0xFFFF;
+};
+
+// Number of cars per (brand, year), for years firstYear..firstYear+years-1
+struct BrandYearCounts {
+    int firstYear = 0;
+    std::size_t years = 0;
+    std::vector<std::size_t> counts; // brand-major: counts[brand * years + (year - firstYear)]
+
+    std::size_t count(std::uint16_t brand, int year) const {
+        if (year < firstYear || std::size_t(year - firstYear) >= years) return 0;
+        std::size_t i = brand * years + std::size_t(year - firstYear);
+        return i < counts.size() ? counts[i] : 0;
+    }
+};
+
+class CarStore {
+public:
+    explicit CarStore(unsigned threads = defaultThreads()) : threads(std::max(threads, 1u)) {}
+
+    // Returns the new car's row number
+    std::size_t add(std::string_view brand, std::string_view model, int year) {
+        if (year < 0 || year > 0xFFFF) throw std::out_of_range("CarStore: year does not fit in 16 bits");
+        std::size_t row = years.size();
+        // Everything that can throw comes first, so a failed add leaves the
+        // columns aligned: the codes (a dictionary may be full), then room
+        // for the row in every column, then push_backs that cannot fail
+        const std::uint16_t brandCode = brandDictionary.encode(brand);
+        const std::uint16_t modelCode = modelDictionary.encode(model);
+        reserveOneMore(brands);
+        reserveOneMore(models);
+        reserveOneMore(years);
+        if (row % 64 == 0) reserveOneMore(live);
+        brands.push_back(brandCode);
+        models.push_back(modelCode);
+        years.push_back(std::uint16_t(year));
+        if (row % 64 == 0) live.push_back(0);
+        live[row / 64] |= std::uint64_t(1) << (row % 64);
+        ++liveRows;
+        minYearSeen = std::min(minYearSeen, year);
+        maxYearSeen = std::max(maxYearSeen, year);
+        return row;
+    }
+
+    std::size_t add(const Car& car) { return add(car.brand, car.model, car.year); }
+
+    // Marks the row dead; returns false if it already was
+    bool erase(std::size_t row) {
+        if (row >= size()) throw std::out_of_range("CarStore::erase: no such row");
+        std::uint64_t bit = std::uint64_t(1) << (row % 64);
+        if (!(live[row / 64] & bit)) return false;
+        live[row / 64] &= ~bit;
+        --liveRows;
+        return true;
+    }
+
+    bool isLive(std::size_t row) const { return (live[row / 64] >> (row % 64)) & 1; }
+
+    void append(std::span<const Car> cars) {
+        brands.reserve(brands.size() + cars.size());
+        models.reserve(models.size() + cars.size());
+        years.reserve(years.size() + cars.size());
+        for (const Car& car : cars) add(car);
+    }
+
+    std::size_t size() const { return years.size(); } // Rows, including erased ones
+    std::size_t liveCount() const { return liveRows; }
+    std::size_t memoryBytes() const { return size() * 3 * sizeof(std::uint16_t) + live.size() * 8; }
+
+    std::string_view brand(std::size_t i) const { return brandDictionary.decode(brands[i]); }
+    std::string_view model(std::size_t i) const { return modelDictionary.decode(models[i]); }
+    int year(std::size_t i) const { return years[i]; }
+
+    // Back to an object (copies the strings)
+    Car load(std::size_t i) const {
+        Car car;
+        car.brand = brand(i);
+        car.model = model(i);
+        car.year = year(i);
+        return car;
+    }
+
+    const Dictionary& brandCodes() const { return brandDictionary; }
+    const Dictionary& modelCodes() const { return modelDictionary; }
+
+    // Whole columns, for custom scans
+    std::span<const std::uint16_t> brandColumn() const { return brands; }
+    std::span<const std::uint16_t> modelColumn() const { return models; }
+    std::span<const std::uint16_t> yearColumn() const { return years; }
+
+    // Bit i is set when car i is live and matches
+    std::vector<std::uint64_t> select(const CarQuery& query) const {
+        std::vector<std::uint64_t> bits((size() + 63) / 64, 0);
+        scan(compile(query), [&](std::size_t, std::size_t base, std::uint64_t word) {
+            bits[base / 64] = word; // Ranges are whole words: no two threads share one
+        });
+        return bits;
+    }
+
+    std::size_t count(const CarQuery& query) const {
+        std::vector<Padded<std::size_t>> partial(threads);
+        scan(compile(query), [&](std::size_t part, std::size_t, std::uint64_t word) {
+            partial[part].value += std::popcount(word);
+        });
+        std::size_t total = 0;
+        for (const auto& p : partial) total += p.value;
+        return total;
+    }
+
+    // Matching cars per brand code (see brandCodes())
+    std::vector<std::size_t> countPerBrand(const CarQuery& query = {}) const {
+        std::vector<std::vector<std::size_t>> partial(threads, std::vector<std::size_t>(brandDictionary.size()));
+        scan(compile(query), [&](std::size_t part, std::size_t base, std::uint64_t word) {
+            std::size_t* counts = partial[part].data();
+            if (word == ~std::uint64_t(0)) {
+                for (unsigned j = 0; j < 64; ++j) ++counts[brands[base + j]];
+                return;
+            }
+            for (; word; word &= word - 1) ++counts[brands[base + std::countr_zero(word)]];
+        });
+        return sum(partial, brandDictionary.size());
+    }
+
+    // Matching cars per (brand, year)
+    BrandYearCounts countPerBrandYear(const CarQuery& query = {}) const {
+        BrandYearCounts result;
+        if (size() == 0) return result;
+        result.firstYear = minYearSeen;
+        result.years = std::size_t(maxYearSeen - minYearSeen + 1);
+        const std::size_t span = result.years;
+        const std::size_t cells = brandDictionary.size() * span;
+        const unsigned first = unsigned(minYearSeen);
+
+        std::vector<std::vector<std::size_t>> partial(threads, std::vector<std::size_t>(cells));
+        scan(compile(query), [&](std::size_t part, std::size_t base, std::uint64_t word) {
+            std::size_t* counts = partial[part].data();
+            if (word == ~std::uint64_t(0)) {
+                for (std::size_t i = base; i < base + 64; ++i) ++counts[brands[i] * span + (years[i] - first)];
+                return;
+            }
+            for (; word; word &= word - 1) {
+                std::size_t i = base + std::countr_zero(word);
+                ++counts[brands[i] * span + (years[i] - first)];
+            }
+        });
+        result.counts = sum(partial, cells);
+        return result;
+    }
+
+private:
+    // Capacity for one more element (doubling, like push_back would), so
+    // the push_back that follows cannot throw
+    template <typename T>
+    static void reserveOneMore(std::vector<T>& v) {
+        if (v.size() == v.capacity()) v.reserve(std::max<std::size_t>(16, 2 * v.capacity()));
+    }
+
+    // One per thread, on its own cache line
+    template <typename T>
+    struct alignas(64) Padded {
+        T value{};
+    };
+
+    // A query as masks: row matches when
+    //   (brand & brandMask) == brandCode, (model & modelMask) == modelCode,
+    //   and year - yearMin <= yearWidth (unsigned)
+    // A mask of 0 turns its test off, so every query runs the same loop.
+    struct Predicate {
+        std::uint16_t brandMask = 0, brandCode = 0;
+        std::uint16_t modelMask = 0, modelCode = 0;
+        std::uint16_t yearMin = 0, yearWidth = 0xFFFF;
+        bool none = false; // Nothing can match
+    };
+
+    Predicate compile(const CarQuery& query) const {
+        Predicate p;
+        if (query.brand) {
+            auto code = brandDictionary.find(*query.brand);
+            p.none |= !code;
+            p.brandMask = 0xFFFF;
+            p.brandCode = code.value_or(0);
+        }
+        if (query.model) {
+            auto code = modelDictionary.find(*query.model);
+            p.none |= !code;
+            p.modelMask = 0xFFFF;
+            p.modelCode = code.value_or(0);
+        }
+        int lo = std::max(query.minYear, 0), hi = std::min(query.maxYear, 0xFFFF);
+        p.none |= lo > hi;
+        p.yearMin = std::uint16_t(lo);
+        p.yearWidth = std::uint16_t(std::max(hi - lo, 0));
+        return p;
+    }
+
+    // Calls fn(part, base, matches) for every 64-row block (base = first row)
+    template <typename Fn>
+    void scan(const Predicate& p, Fn fn) const {
+        if (p.none) return;
+        const std::uint16_t* b = brands.data();
+        const std::uint16_t* m = models.data();
+        const std::uint16_t* y = years.data();
+        parallelRanges(size(), threads, 64, [&](std::size_t part, std::size_t begin, std::size_t end) {
+            std::size_t row = begin;
+            for (; row + 64 <= end; row += 64) {
+                // 1) One 0/1 byte per row: a plain compare loop the compiler vectorises
+                std::uint8_t flags[64];
+                for (unsigned j = 0; j < 64; ++j) {
+                    flags[j] = ((b[row + j] & p.brandMask) == p.brandCode) &
+                               ((m[row + j] & p.modelMask) == p.modelCode) &
+                               (std::uint16_t(y[row + j] - p.yearMin) <= p.yearWidth);
+                }
+                // 2) Pack 8 flag bytes into 8 bits with one multiply (little-endian)
+                std::uint64_t word = 0;
+                for (unsigned j = 0; j < 64; j += 8) {
+                    std::uint64_t eight;
+                    std::memcpy(&eight, flags + j, 8);
+                    word |= ((eight * 0x0102040810204080ULL) >> 56) << j;
+                }
+                word &= live[row / 64];
+                if (word) fn(part, row, word);
+            }
+            if (row < end) {
+                std::uint64_t word = 0;
+                for (unsigned j = 0; row + j < end; ++j) {
+                    bool match = ((b[row + j] & p.brandMask) == p.brandCode) &
+                                 ((m[row + j] & p.modelMask) == p.modelCode) &
+                                 (std::uint16_t(y[row + j] - p.yearMin) <= p.yearWidth);
+                    word |= std::uint64_t(match) << j;
+                }
+                word &= live[row / 64];
+                if (word) fn(part, row, word);
+            }
+        });
+    }
+
+    static std::vector<std::size_t> sum(const std::vector<std::vector<std::size_t>>& partial, std::size_t n) {
+        std::vector<std::size_t> total(n, 0);
+        for (const auto& counts : partial) {
+            for (std::size_t i = 0; i < n; ++i) total[i] += counts[i];
+        }
+        return total;
+    }
+
+    unsigned threads;
+    Dictionary brandDictionary;
+    Dictionary modelDictionary;
+    std::vector<std::uint16_t> brands;
+    std::vector<std::uint16_t> models;
+    std::vector<std::uint16_t> years;
+    std::vector<std::uint64_t> live; // 1 bit per row, cleared by erase()
+    std::size_t liveRows = 0;
+    int minYearSeen = 0xFFFF;
+    int maxYearSeen = 0;
+};
+
+} // namespace oops
@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * Build configuration
+ *
+ * Every header works on its own: `g++ -std=c++20 Demo.cpp` needs nothing else.
+ * The CMake build instead links each program against the oops shared library
+ * and defines OOPS_SHARED, which moves the process-wide singletons
+ * (StringInterner::global, InstanceRegistry::instance,
+ * DispatchProfiler::instance, LockOrderGraph::instance, ThreadPool::global)
+ * into the library, so there is exactly one of each however many modules
+ * are loaded.
+ */
+
+#if defined(OOPS_SHARED)
+#if defined(_WIN32)
+#if defined(OOPS_BUILDING_LIBRARY)
+#define OOPS_API __declspec(dllexport)
+#else
+#define OOPS_API __declspec(dllimport)
+#endif
+#else
+#define OOPS_API __attribute__((visibility("default")))
+#endif
+#else
+#define OOPS_API
+#endif
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+
+#include "config.hpp"
+#include "type_name.hpp"
+
+/**
+ * Virtual Dispatch Profiler (opt-in)
+ *
+ * Wrap the object of a virtual call to count which concrete types reach each
+ * call site:
+ *
+ *     OOPS_DISPATCH(Animal, myAnimal)->makeSound();
+ *
+ * Compiled with -DOOPS_PROFILE_DISPATCH, every call records
+ * (interface, dynamic type, file:line). Without it the macro expands to the
+ * plain pointer, so the instrumentation costs nothing.
+ *
+ * oops::DispatchProfiler::instance().report(std::cout) prints one block per
+ * call site, classified the way JIT compilers classify inline caches:
+ *   monomorphic  - 1 type     -> devirtualise / mark the class final
+ *   polymorphic  - 2..4 types -> partition the data by type, or switch on it
+ *   megamorphic  - 5+ types   -> leave the vtable alone
+ */
+
+namespace oops {
+
+// Counters for a single call site. Each site owns a fixed table of type
+// slots so recording a call is a few atomic operations and never allocates.
+class DispatchSite {
+public:
+    static constexpr int kMaxTypes = 8;
+
+    DispatchSite(const char* interface, const char* file, int line);
+
+    void record(const std::type_info& type) {
+        for (auto& slot : slots) {
+            const std::type_info* seen = slot.type.load(std::memory_order_acquire);
+            if (seen == nullptr) {
+                // Claim an empty slot; if another thread won the race, re-check it
+                if (slot.type.compare_exchange_strong(seen, &type, std::memory_order_acq_rel)) {
+                    seen = &type;
+                }
+            }
+            if (seen == &type || *seen == type) {
+                slot.calls.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        otherTypes.fetch_add(1, std::memory_order_relaxed); // Table full
+    }
+
+private:
+    friend class DispatchProfiler;
+
+    struct Slot {
+        std::atomic<const std::type_info*> type{nullptr};
+        std::atomic<std::uint64_t> calls{0};
+    };
+
+    const char* interface;
+    const char* file;
+    int line;
+    Slot slots[kMaxTypes];
+    std::atomic<std::uint64_t> otherTypes{0};
+};
+
+class OOPS_API DispatchProfiler {
+public:
+#ifdef OOPS_SHARED
+    static DispatchProfiler& instance(); // Defined once, in the oops library
+#else
+    static DispatchProfiler& instance() {
+        static DispatchProfiler profiler;
+        return profiler;
+    }
+#endif
+
+    void registerSite(DispatchSite* site) {
+        std::lock_guard<std::mutex> lock(mtx);
+        sites.push_back(site);
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (DispatchSite* site : sites) {
+            for (auto& slot : site->slots) {
+                slot.calls.store(0, std::memory_order_relaxed);
+            }
+            site->otherTypes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void report(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        out << "=== Virtual Dispatch Profile (" << sites.size() << " call sites) ===\n";
+
+        for (const DispatchSite* site : sites) {
+            std::vector<std::pair<std::uint64_t, const std::type_info*>> types;
+            std::uint64_t total = site->otherTypes.load(std::memory_order_relaxed);
+            for (const auto& slot : site->slots) {
+                const std::type_info* type = slot.type.load(std::memory_order_acquire);
+                std::uint64_t calls = slot.calls.load(std::memory_order_relaxed);
+                if (type != nullptr && calls > 0) {
+                    types.emplace_back(calls, type);
+                    total += calls;
+                }
+            }
+            if (total == 0) continue;
+            std::sort(types.rbegin(), types.rend());
+
+            bool overflowed = site->otherTypes.load(std::memory_order_relaxed) > 0;
+            out << site->file << ":" << site->line << "  " << site->interface
+                << "  calls=" << total << "  " << classify(types.size(), overflowed) << "\n";
+            for (const auto& [calls, type] : types) {
+                out << "    " << std::setw(6) << std::fixed << std::setprecision(2)
+                    << 100.0 * double(calls) / double(total) << "%  " << demangle(*type)
+                    << " (" << calls << ")\n";
+            }
+            if (overflowed) {
+                out << "    (other types: " << site->otherTypes.load(std::memory_order_relaxed) << ")\n";
+            }
+        }
+    }
+
+private:
+    DispatchProfiler() = default;
+
+    static const char* classify(std::size_t typeCount, bool overflowed) {
+        if (overflowed || typeCount > 4) return "MEGAMORPHIC";
+        return typeCount == 1 ? "MONOMORPHIC" : "POLYMORPHIC";
+    }
+
+    mutable std::mutex mtx;
+    std::vector<DispatchSite*> sites;
+};
+
+inline DispatchSite::DispatchSite(const char* interface, const char* file, int line)
+    : interface(interface), file(file), line(line) {
+    DispatchProfiler::instance().registerSite(this);
+}
+
+} // namespace oops
+
+#if defined(OOPS_PROFILE_DISPATCH)
+// Each expansion is a distinct lambda, so each call site gets its own static DispatchSite
+#define OOPS_DISPATCH(Interface, ptr)                                          \
+    ([](Interface* object) {                                                   \
+        static ::oops::DispatchSite site(#Interface, __FILE__, __LINE__);      \
+        site.record(typeid(*object));                                          \
+        return object;                                                         \
+    }(ptr))
+#else
+#define OOPS_DISPATCH(Interface, ptr) (ptr)
+#endif
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "locks.hpp" // TtasSpinLock, Backoff
+
+/**
+ * FlatCombining<T> - one thread applies everyone's updates
+ *
+ * Under a lock, every update moves the lock's and the value's cache lines
+ * to the updating core, one thread at a time. With flat combining a thread
+ * publishes its operation in a slot of its own and whoever gets the lock
+ * (the combiner) applies all published operations in one pass, while the
+ * value stays in its cache; the others only wait for their slot to say
+ * "done" (Hendler, Incze, Shavit & Tzafrir, "Flat Combining and the
+ * Synchronization-Parallelism Tradeoff", SPAA 2010).
+ *
+ *     oops::FlatCombining<long> total;
+ *     total.apply([](long& t) { t += 5; });
+ *
+ *     oops::FlatCombining<oops::BankAccount> account("12345", "John Doe", 0.0);
+ *     oops::Result<> r = account.apply([](oops::BankAccount& a) { return a.withdraw(20.0); });
+ *
+ * apply() returns what the operation returns and rethrows what it throws,
+ * in the calling thread. Operations run one at a time, in no particular
+ * order across threads. It pays off only under contention: alone, a thread
+ * publishes, combines its own operation and collects the result.
+ */
+
+namespace oops {
+
+namespace detail {
+
+// A small number per thread, to pick slots and shards. Threads started
+// later get new numbers; users reduce them modulo their table size.
+inline unsigned threadIndex() {
+    static std::atomic<unsigned> next{0};
+    thread_local const unsigned index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace detail
+
+template <typename T, std::size_t Slots = 128>
+class FlatCombining {
+public:
+    template <typename... Args>
+    explicit FlatCombining(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    FlatCombining(const FlatCombining&) = delete;
+    FlatCombining& operator=(const FlatCombining&) = delete;
+
+    // Runs fn(T&) with exclusive access to the value, possibly on another
+    // thread, and returns its result
+    template <typename Fn>
+    decltype(auto) apply(Fn&& fn) {
+        using R = std::invoke_result_t<Fn&, T&>;
+        Request<Fn, R> request(fn);
+        run(&Request<Fn, R>::invoke, &request);
+        if (request.error) std::rethrow_exception(request.error);
+        if constexpr (!std::is_void_v<R>) {
+            return static_cast<R>(std::move(*request.result));
+        }
+    }
+
+    // Operations applied by a combiner other than their caller, so far.
+    // The higher, the more the batching is saving.
+    std::uint64_t combinedForOthers() const { return forOthers.load(std::memory_order_relaxed); }
+
+private:
+    using Invoke = void (*)(void* request, T& value);
+
+    enum : std::uint32_t {
+        Free,
+        Claimed, // Its thread is filling in the request
+        Pending, // Published, waiting for a combiner
+        Done,    // Applied; its thread may collect the result
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint32_t> state{Free};
+        Invoke invoke = nullptr;
+        void* request = nullptr;
+    };
+
+    // An operation and its outcome, on the caller's stack
+    template <typename Fn, typename R>
+    struct Request {
+        explicit Request(Fn& fn) : fn(fn) {}
+
+        Fn& fn;
+        std::conditional_t<std::is_void_v<R>, bool,
+                           std::optional<std::conditional_t<std::is_reference_v<R>,
+                                                            std::reference_wrapper<std::remove_reference_t<R>>, R>>>
+            result{};
+        std::exception_ptr error;
+
+        static void invoke(void* request, T& value) {
+            auto& self = *static_cast<Request*>(request);
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    self.fn(value);
+                } else {
+                    self.result.emplace(self.fn(value));
+                }
+            } catch (...) {
+                self.error = std::current_exception();
+            }
+        }
+    };
+
+    void run(Invoke invoke, void* request) {
+        const std::size_t index = detail::threadIndex() % Slots;
+        Slot& slot = slots[index];
+
+        std::uint32_t expected = Free;
+        if (!slot.state.compare_exchange_strong(expected, Claimed, std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+            // Another thread maps to this slot and is using it: take the lock
+            std::lock_guard<TtasSpinLock> guard(lock);
+            invoke(request, value);
+            return;
+        }
+        // The combiner scans slots [0, used)
+        std::size_t seen = used.load(std::memory_order_relaxed);
+        while (seen <= index && !used.compare_exchange_weak(seen, index + 1, std::memory_order_relaxed)) {
+            // `seen` now holds the current value; retry unless it covers us
+        }
+        slot.invoke = invoke;
+        slot.request = request;
+        slot.state.store(Pending, std::memory_order_release); // Publishes invoke and request
+
+        Backoff backoff;
+        while (slot.state.load(std::memory_order_acquire) != Done) {
+            if (lock.try_lock()) {
+                combine(index);
+                lock.unlock();
+            } else {
+                backoff.pause();
+            }
+        }
+        // Release: a thread sharing the slot may claim it next and overwrite
+        // the request fields
+        slot.state.store(Free, std::memory_order_release);
+    }
+
+    // Applies every pending operation. A couple of passes pick up the
+    // operations published while the first one ran.
+    void combine(std::size_t self) {
+        for (int pass = 0; pass < kPasses; ++pass) {
+            std::size_t applied = 0;
+            std::size_t others = 0;
+            const std::size_t n = used.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < n; ++i) {
+                Slot& slot = slots[i];
+                if (slot.state.load(std::memory_order_acquire) != Pending) continue;
+                slot.invoke(slot.request, value); // Catches what the operation throws
+                slot.state.store(Done, std::memory_order_release);
+                ++applied;
+                others += i != self;
+            }
+            if (others) forOthers.fetch_add(others, std::memory_order_relaxed);
+            if (applied == 0) break;
+        }
+    }
+
+    static constexpr int kPasses = 2;
+
+    alignas(64) TtasSpinLock lock;
+    alignas(64) T value;
+    alignas(64) std::atomic<std::size_t> used{0};
+    std::atomic<std::uint64_t> forOthers{0};
+    std::array<Slot, Slots> slots;
+};
+
+} // namespace oops
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+// Vehicle and Car are names other modules use too, hence the namespace
+namespace oops::inheritance {
+
+// Base Class
+class Vehicle {
+public:
+    std::string brand = "Generic Vehicle";
+
+    void honk() {
+        std::cout << "Tuut, tuut!\n";
+    }
+};
+
+// Derived Class
+class Car : public Vehicle {
+public:
+    std::string modelName = "Mustang";
+};
+
+} // namespace oops::inheritance
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "config.hpp"
+#include "type_name.hpp"
+
+/**
+ * InstanceCounted<T> - contention-free "how many T objects exist?"
+ *
+ *     class Example : public oops::InstanceCounted<Example> { ... };
+ *     Example::created();  // objects ever constructed
+ *     Example::alive();    // constructed - destroyed
+ *
+ * A plain `static int count` is racy, and a `static std::atomic<int>` makes
+ * every constructor on every thread fight over one cache line. Here each
+ * thread bumps its own cache-line sized slot (a plain load + store, no locked
+ * instruction); reads add up all slots. Reads are therefore the slow side and
+ * are only a consistent snapshot once the counting threads are quiet.
+ *
+ * Every counted type also shows up in InstanceRegistry, which reports live
+ * objects and creation rate per type. Classes that only want these
+ * statistics in instrumented builds derive from Tracked<T> instead: it is
+ * InstanceCounted<T> with -DOOPS_INSTANCE_STATS and an empty base otherwise.
+ */
+
+namespace oops {
+
+// Point-in-time statistics for one counted type
+struct InstanceStats {
+    std::string type;
+    std::int64_t created = 0;
+    std::int64_t destroyed = 0;
+    std::int64_t alive = 0;
+    // Highest `alive` any read has seen. The true peak may fall between two
+    // reads: tracking it exactly would take a shared counter per constructor.
+    std::int64_t peakSampled = 0;
+    double createdPerSecond = 0.0; // Since this reader's previous snapshot
+};
+
+namespace detail {
+
+// One per (thread, counted type). Only the owning thread writes it.
+struct alignas(64) CounterSlot {
+    std::atomic<std::int64_t> created{0};
+    std::atomic<std::int64_t> destroyed{0};
+
+    static void bump(std::atomic<std::int64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void onCreate() { bump(created); }
+    void onDestroy() { bump(destroyed); }
+};
+
+struct CounterTotals {
+    std::int64_t created = 0;
+    std::int64_t destroyed = 0;
+};
+
+class CounterRegistry;
+
+} // namespace detail
+
+// What one reader (a dumper, a dashboard) saw at its previous snapshot, so
+// that each reader's createdPerSecond covers its own interval
+class InstanceStatsCursor {
+    friend class InstanceRegistry;
+
+    struct Mark {
+        std::int64_t created = 0;
+        std::chrono::steady_clock::time_point at;
+    };
+    std::unordered_map<const detail::CounterRegistry*, Mark> marks;
+};
+
+// Every counted type, for reporting
+class OOPS_API InstanceRegistry {
+public:
+#ifdef OOPS_SHARED
+    static InstanceRegistry& instance(); // Defined once, in the oops library
+#else
+    static InstanceRegistry& instance() {
+        static InstanceRegistry registry;
+        return registry;
+    }
+#endif
+
+    void add(detail::CounterRegistry* type) {
+        std::lock_guard<std::mutex> lock(mtx);
+        types.push_back(type);
+    }
+
+    // Statistics for every type that has constructed at least one object.
+    // createdPerSecond is since the cursor's previous snapshot; without one,
+    // since the type's first object.
+    std::vector<InstanceStats> snapshot(InstanceStatsCursor& cursor);
+
+    std::vector<InstanceStats> snapshot() {
+        InstanceStatsCursor fresh;
+        return snapshot(fresh);
+    }
+
+    // Prometheus text exposition format, ready to be scraped
+    void dump(std::ostream& out, InstanceStatsCursor& cursor) {
+        std::vector<InstanceStats> stats = snapshot(cursor);
+        auto metric = [&](const char* name, const char* kind, auto field) {
+            out << "# TYPE oops_instances_" << name << " " << kind << "\n";
+            for (const InstanceStats& s : stats) {
+                out << "oops_instances_" << name << "{type=\"" << s.type << "\"} " << s.*field << "\n";
+            }
+        };
+        metric("created_total", "counter", &InstanceStats::created);
+        metric("destroyed_total", "counter", &InstanceStats::destroyed);
+        metric("alive", "gauge", &InstanceStats::alive);
+        metric("peak_sampled", "gauge", &InstanceStats::peakSampled);
+        metric("created_per_second", "gauge", &InstanceStats::createdPerSecond);
+        out.flush();
+    }
+
+    void dump(std::ostream& out) {
+        InstanceStatsCursor fresh;
+        dump(out, fresh);
+    }
+
+private:
+    InstanceRegistry() = default;
+
+    std::mutex mtx;
+    std::vector<detail::CounterRegistry*> types;
+};
+
+namespace detail {
+
+// All live slots of one type, plus the totals of threads that have exited
+class CounterRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit CounterRegistry(std::string name)
+        : name(std::move(name)), started(Clock::now()) {
+        InstanceRegistry::instance().add(this);
+    }
+
+    void add(CounterSlot* slot) {
+        std::lock_guard<std::mutex> lock(mtx);
+        slots.push_back(slot);
+    }
+
+    void retire(CounterSlot* slot) {
+        std::lock_guard<std::mutex> lock(mtx);
+        retired.created += slot->created.load(std::memory_order_relaxed);
+        retired.destroyed += slot->destroyed.load(std::memory_order_relaxed);
+        slots.erase(std::find(slots.begin(), slots.end(), slot));
+    }
+
+    // For objects counted after their thread's slot is gone (see localSlot)
+    void onCreateShared() { sharedCreated.fetch_add(1, std::memory_order_relaxed); }
+    void onDestroyShared() { sharedDestroyed.fetch_add(1, std::memory_order_relaxed); }
+
+    CounterTotals totals() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return sumLocked();
+    }
+
+    Clock::time_point startTime() const { return started; }
+
+    // `lastCreated` / `lastSample`: the reader's previous snapshot, updated
+    InstanceStats sample(std::int64_t& lastCreated, Clock::time_point& lastSample) {
+        std::lock_guard<std::mutex> lock(mtx);
+        CounterTotals sum = sumLocked();
+        Clock::time_point now = Clock::now();
+        double seconds = std::chrono::duration<double>(now - lastSample).count();
+
+        InstanceStats stats;
+        stats.type = name;
+        stats.created = sum.created;
+        stats.destroyed = sum.destroyed;
+        stats.alive = sum.created - sum.destroyed;
+        stats.peakSampled = peak;
+        stats.createdPerSecond = seconds > 0 ? double(sum.created - lastCreated) / seconds : 0.0;
+
+        lastCreated = sum.created;
+        lastSample = now;
+        return stats;
+    }
+
+private:
+    CounterTotals sumLocked() {
+        CounterTotals sum = retired;
+        sum.created += sharedCreated.load(std::memory_order_relaxed);
+        sum.destroyed += sharedDestroyed.load(std::memory_order_relaxed);
+        for (const CounterSlot* slot : slots) {
+            sum.created += slot->created.load(std::memory_order_relaxed);
+            sum.destroyed += slot->destroyed.load(std::memory_order_relaxed);
+        }
+        peak = std::max(peak, sum.created - sum.destroyed);
+        return sum;
+    }
+
+    std::mutex mtx;
+    std::vector<CounterSlot*> slots;
+    CounterTotals retired;
+    std::atomic<std::int64_t> sharedCreated{0};
+    std::atomic<std::int64_t> sharedDestroyed{0};
+
+    const std::string name;
+    const Clock::time_point started;
+    std::int64_t peak = 0; // Highest created - destroyed seen by sumLocked
+};
+
+template <typename T>
+CounterRegistry& counterRegistry() {
+    static CounterRegistry registry(demangle(typeid(T)));
+    return registry;
+}
+
+// thread_local wrapper: registers on first use in a thread, folds its
+// counts into the registry when the thread exits
+template <typename T>
+struct ThreadCounterSlot {
+    CounterSlot slot;
+
+    // Set when this thread's slot is destroyed. A plain bool has no
+    // destructor, so it can still be read after thread_local destruction.
+    static inline thread_local bool destroyed = false;
+
+    ThreadCounterSlot() { counterRegistry<T>().add(&slot); }
+    ~ThreadCounterSlot() {
+        counterRegistry<T>().retire(&slot);
+        destroyed = true;
+    }
+};
+
+} // namespace detail
+
+inline std::vector<InstanceStats> InstanceRegistry::snapshot(InstanceStatsCursor& cursor) {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<InstanceStats> stats;
+    stats.reserve(types.size());
+    for (detail::CounterRegistry* type : types) {
+        auto [it, fresh] = cursor.marks.try_emplace(type);
+        if (fresh) it->second.at = type->startTime();
+        stats.push_back(type->sample(it->second.created, it->second.at));
+    }
+    return stats;
+}
+
+template <typename T>
+class InstanceCounted {
+public:
+    // Number of T objects ever constructed (including copies)
+    static std::int64_t created() {
+        return detail::counterRegistry<T>().totals().created;
+    }
+
+    // Number of T objects currently alive
+    static std::int64_t alive() {
+        detail::CounterTotals totals = detail::counterRegistry<T>().totals();
+        return totals.created - totals.destroyed;
+    }
+
+protected:
+    // Protected: only meaningful as a base class
+    InstanceCounted() { countCreate(); }
+    InstanceCounted(const InstanceCounted&) { countCreate(); }
+    InstanceCounted& operator=(const InstanceCounted&) = default; // Assignment creates nothing
+    ~InstanceCounted() {
+        if (detail::CounterSlot* slot = localSlot()) {
+            slot->onDestroy();
+        } else {
+            detail::counterRegistry<T>().onDestroyShared();
+        }
+    }
+
+private:
+    static void countCreate() {
+        if (detail::CounterSlot* slot = localSlot()) {
+            slot->onCreate();
+        } else {
+            detail::counterRegistry<T>().onCreateShared();
+        }
+    }
+
+    // nullptr once this thread's slot has been destroyed: a T with static
+    // storage duration, or one a thread_local destructor creates or
+    // destroys, is counted in the registry's shared slot instead
+    static detail::CounterSlot* localSlot() {
+        if (detail::ThreadCounterSlot<T>::destroyed) return nullptr;
+        thread_local detail::ThreadCounterSlot<T> local;
+        return &local.slot;
+    }
+};
+
+// Opt-in statistics: counted only in builds with -DOOPS_INSTANCE_STATS.
+// Otherwise an empty base class, which the compiler removes entirely.
+#if defined(OOPS_INSTANCE_STATS)
+template <typename T>
+using Tracked = InstanceCounted<T>;
+#else
+template <typename T>
+class Tracked {};
+#endif
+
+// Background thread that writes InstanceRegistry::dump() every `interval`
+// (e.g. to a file a metrics agent scrapes). Stops when destroyed.
+class InstanceStatsDumper {
+public:
+    InstanceStatsDumper(std::ostream& out, std::chrono::milliseconds interval)
+        : worker([this, &out, interval] {
+              InstanceStatsCursor cursor; // Rates per interval, whoever else reads
+              std::unique_lock<std::mutex> lock(mtx);
+              while (!cv.wait_for(lock, interval, [this] { return stopping; })) {
+                  InstanceRegistry::instance().dump(out, cursor);
+              }
+          }) {}
+
+    ~InstanceStatsDumper() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_one();
+        worker.join();
+    }
+
+    InstanceStatsDumper(const InstanceStatsDumper&) = delete;
+    InstanceStatsDumper& operator=(const InstanceStatsDumper&) = delete;
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread worker; // Declared last: starts after the members it uses
+};
+
+} // namespace oops
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <iostream>
+#include <string_view>
+
+#include "instance_counted.hpp"
+#include "string_interner.hpp"
+
+namespace oops {
+
+// InstanceCounted<Example> holds the per-class (static) counters, so every
+// constructor/destructor updates them - thread-safe, without a shared hot spot
+class Example : public InstanceCounted<Example> {
+public:
+    InternedString name; // 4-byte id; the text is stored once per distinct name
+
+    // string_view: no std::string is built; an already-interned name costs no allocation
+    Example(std::string_view name) {
+        this->name = InternedString(name); // 'this' is a pointer to the current object
+    }
+
+    // Const member function: cannot modify object state
+    void display() const {
+        std::cout << "Name: " << this->name << std::endl;
+        // name = "New Name"; // Error: Cannot modify in const function
+    }
+
+    // Static method: called on the class, no object needed
+    static void showCount() {
+        std::cout << "Total Objects: " << created() << " (alive: " << alive() << ")" << std::endl;
+    }
+};
+
+} // namespace oops
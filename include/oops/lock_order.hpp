@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+#include "locks.hpp" // Lockable
+
+/**
+ * Lock-order checking (opt-in) - finds deadlocks that did not happen
+ *
+ * Two threads that take the same two locks in opposite orders can
+ * deadlock, but only when their timing lines up; a test run usually gets
+ * lucky. LockOrderGraph records, for every lock taken while others are
+ * held, the edge "held -> taken" (as the Linux kernel's lockdep does). An
+ * edge that closes a cycle is a lock order some interleaving of the same
+ * code can deadlock on, and is reported the first time it is seen:
+ *
+ *     oops::CheckedMutex<> from("account A"), to("account B");
+ *     // Thread 1: lock(from) then lock(to)   -> edge A -> B
+ *     // Thread 2: lock(to) then lock(from)   -> edge B -> A: cycle reported
+ *
+ * Compiled with -DOOPS_CHECK_LOCK_ORDER, CheckedMutex<Lock> checks; without
+ * it, it is a plain Lock that ignores its name. OrderCheckedMutex<Lock>
+ * always checks. The library's own locks that user code can hold while
+ * taking others (the counters of thread_safety.hpp, StringInterner,
+ * Pipeline) are CheckedMutexes. Registries, the thread pool and this graph
+ * keep plain mutexes: they are taken during thread and program exit, when
+ * the per-thread lists below may already be gone.
+ *
+ * A destroyed lock leaves the graph with its edges, so objects that come
+ * and go (one mutex per account) do not make it grow without bound. Ids
+ * are never reused.
+ *
+ * Cost: a lock taken with nothing else held is one push onto a per-thread
+ * list. A nested one looks its edges up in a per-thread set; only an edge
+ * this thread has never taken before goes to the shared graph (a mutex and,
+ * for a new edge, a depth-first search). try_lock() adds no edges, since it
+ * cannot block.
+ */
+
+namespace oops {
+
+// A lock-order cycle: cycle[0] was taken while holding cycle.back(), and
+// each lock was taken while holding the previous one
+struct LockOrderViolation {
+    std::vector<std::string> cycle;
+
+    std::string describe() const {
+        std::string text;
+        for (const std::string& name : cycle) text += name + " -> ";
+        return text + (cycle.empty() ? std::string("?") : cycle.front());
+    }
+};
+
+class OOPS_API LockOrderGraph {
+public:
+#ifdef OOPS_SHARED
+    static LockOrderGraph& instance(); // Defined once, in the oops library
+#else
+    static LockOrderGraph& instance() {
+        static LockOrderGraph graph;
+        return graph;
+    }
+#endif
+
+    using Handler = std::function<void(const LockOrderViolation&)>;
+
+    // Called for each new cycle. The default prints it to std::cerr; a test
+    // can throw or abort instead.
+    void onViolation(Handler handler) {
+        std::lock_guard<std::mutex> guard(mtx);
+        this->handler = std::move(handler);
+    }
+
+    std::uint64_t violations() const { return violationCount.load(std::memory_order_relaxed); }
+
+    // A new id for each checked lock
+    std::uint32_t registerLock(const char* name) {
+        const std::uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> guard(mtx);
+        names[id] = name ? name : "lock #" + std::to_string(id);
+        return id;
+    }
+
+    // The lock is being destroyed: forgets its name and every edge into or
+    // out of it. A lock that no longer exists cannot deadlock.
+    void unregisterLock(std::uint32_t id) {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            if (auto out = edges.find(id); out != edges.end()) {
+                for (std::uint32_t to : out->second) std::erase(incoming[to], id);
+                edges.erase(out);
+            }
+            if (auto in = incoming.find(id); in != incoming.end()) {
+                for (std::uint32_t from : in->second) std::erase(edges[from], id);
+                incoming.erase(in);
+            }
+            names.erase(id);
+        }
+        retired.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Before blocking on `id`: records held -> id for every held lock
+    void beforeLock(std::uint32_t id) {
+        Held& held = heldLocks();
+        if (held.ids.empty()) return;
+        forgetRetiredEdges(held);
+        for (std::uint32_t from : held.ids) {
+            if (from == id) continue; // Recursive locking is the lock's business
+            const std::uint64_t edge = (std::uint64_t(from) << 32) | id;
+            if (held.knownEdges.insert(edge).second) addEdge(from, id);
+        }
+    }
+
+    void acquired(std::uint32_t id) { heldLocks().ids.push_back(id); }
+
+    void released(std::uint32_t id) {
+        std::vector<std::uint32_t>& ids = heldLocks().ids;
+        // Usually the most recent one; any order is allowed
+        auto it = std::find(ids.rbegin(), ids.rend(), id);
+        if (it != ids.rend()) ids.erase(std::next(it).base());
+    }
+
+private:
+    LockOrderGraph() = default;
+
+    // Locks the calling thread holds, and the edges it has already added
+    struct Held {
+        std::vector<std::uint32_t> ids;
+        std::unordered_set<std::uint64_t> knownEdges;
+        std::uint64_t retiredSeen = 0; // `retired` when knownEdges was last cleared
+        std::size_t clearAt = 64;      // knownEdges size that triggers the next check
+    };
+
+    static Held& heldLocks() {
+        thread_local Held held;
+        return held;
+    }
+
+    // knownEdges may name destroyed locks. Ids are not reused, so those
+    // entries are only dead weight: once the set has doubled and locks have
+    // been destroyed since, start over (edges still in the graph are found
+    // there again, under the mutex, once each).
+    void forgetRetiredEdges(Held& held) {
+        if (held.knownEdges.size() < held.clearAt) return;
+        const std::uint64_t now = retired.load(std::memory_order_relaxed);
+        if (now != held.retiredSeen) {
+            held.knownEdges.clear();
+            held.retiredSeen = now;
+        }
+        held.clearAt = std::max<std::size_t>(64, 2 * held.knownEdges.size());
+    }
+
+    void addEdge(std::uint32_t from, std::uint32_t to) {
+        LockOrderViolation violation;
+        Handler report;
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            std::vector<std::uint32_t>& next = edges[from];
+            if (std::find(next.begin(), next.end(), to) != next.end()) return; // Another thread added it
+            next.push_back(to);
+            incoming[to].push_back(from);
+
+            // The new edge closes a cycle if `from` was already reachable from `to`
+            std::vector<std::uint32_t> path;
+            std::unordered_set<std::uint32_t> visited;
+            if (!findPath(to, from, path, visited)) return;
+            for (std::uint32_t id : path) violation.cycle.push_back(names[id]);
+            report = handler;
+        }
+        violationCount.fetch_add(1, std::memory_order_relaxed);
+        // Outside the mutex: the handler may take checked locks itself
+        if (report) {
+            report(violation);
+        } else {
+            std::cerr << "oops: potential deadlock, lock order cycle " << violation.describe() << "\n";
+        }
+    }
+
+    // Depth-first search; on success `path` runs from `at` to `target`
+    bool findPath(std::uint32_t at, std::uint32_t target, std::vector<std::uint32_t>& path,
+                  std::unordered_set<std::uint32_t>& visited) {
+        path.push_back(at);
+        if (at == target) return true;
+        if (visited.insert(at).second) {
+            auto it = edges.find(at);
+            if (it != edges.end()) {
+                for (std::uint32_t next : it->second) {
+                    if (findPath(next, target, path, visited)) return true;
+                }
+            }
+        }
+        path.pop_back();
+        return false;
+    }
+
+    mutable std::mutex mtx;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> edges;    // from -> to
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> incoming; // to -> from
+    std::unordered_map<std::uint32_t, std::string> names;
+    Handler handler;
+    std::atomic<std::uint32_t> nextId{0};
+    std::atomic<std::uint64_t> violationCount{0};
+    std::atomic<std::uint64_t> retired{0}; // Locks unregistered so far
+};
+
+// A Lock whose acquisitions are checked against LockOrderGraph
+template <Lockable Lock = std::mutex>
+class OrderCheckedMutex {
+public:
+    explicit OrderCheckedMutex(const char* name = nullptr) : id(LockOrderGraph::instance().registerLock(name)) {}
+    ~OrderCheckedMutex() { LockOrderGraph::instance().unregisterLock(id); }
+
+    OrderCheckedMutex(const OrderCheckedMutex&) = delete;
+    OrderCheckedMutex& operator=(const OrderCheckedMutex&) = delete;
+
+    void lock() {
+        LockOrderGraph& graph = LockOrderGraph::instance();
+        graph.beforeLock(id);
+        inner.lock();
+        graph.acquired(id);
+    }
+
+    bool try_lock() {
+        if (!inner.try_lock()) return false;
+        LockOrderGraph::instance().acquired(id);
+        return true;
+    }
+
+    void unlock() {
+        LockOrderGraph::instance().released(id);
+        inner.unlock();
+    }
+
+private:
+    Lock inner;
+    std::uint32_t id;
+};
+
+#ifdef OOPS_CHECK_LOCK_ORDER
+template <Lockable Lock = std::mutex>
+using CheckedMutex = OrderCheckedMutex<Lock>;
+#else
+// Lock-order checking is off: just the Lock
+template <Lockable Lock = std::mutex>
+class CheckedMutex : public Lock {
+public:
+    explicit CheckedMutex(const char* /*name*/ = nullptr) {}
+};
+#endif
+
+} // namespace oops
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp" // defaultThreads()
+
+/**
+ * Locks - alternatives to std::mutex for short critical sections
+ *
+ * Every lock here is Lockable (lock / unlock / try_lock), so it works with
+ * std::lock_guard, std::unique_lock and std::scoped_lock like std::mutex:
+ *
+ *     oops::LockedCounter<oops::TicketLock> counter;
+ *     oops::Guarded<oops::BankAccount, oops::RwSpinLock> account("12345", "John Doe", 100.0);
+ *     double balance = account.read([](const oops::BankAccount& a) { return a.getBalance(); });
+ *
+ * | Lock          | Waiting                            | Good at                            |
+ * | ------------- | ---------------------------------- | ---------------------------------- |
+ * | TtasSpinLock  | Spins on a read, backs off         | Low contention, tiny sections      |
+ * | TicketLock    | Spins on "now serving"             | Fairness (FIFO)                    |
+ * | McsLock       | Each waiter spins on its own node  | Many waiters: no shared cache line |
+ * | AdaptiveMutex | Spins briefly, then sleeps (futex) | Sections of unknown length         |
+ * | RwSpinLock    | Readers share, writers exclusive   | Read-mostly data (getBalance)      |
+ *
+ * With more threads than CPUs, spinning wastes the time slices a preempted
+ * holder needs. Once their backoff runs out, TtasSpinLock and RwSpinLock
+ * yield the CPU; TicketLock and McsLock, which hand the lock to one
+ * particular waiter, put their waiters to sleep on a futex instead.
+ */
+
+namespace oops {
+
+// The body of a spin loop: tells the CPU (and its hyperthread sibling)
+// that this core is only waiting
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// How many cpuRelax() a waiter may spend before it sleeps. Spinning only
+// pays off while the holder runs on another CPU: on one CPU, not at all.
+inline unsigned spinBudget() {
+    static const unsigned budget = defaultThreads() > 1 ? 2048 : 0;
+    return budget;
+}
+
+// Exponential backoff: 1, 2, 4, ... pauses up to a cap, then yields the
+// CPU on every call
+class Backoff {
+public:
+    void pause() {
+        if (spins > kMaxSpins) {
+            std::this_thread::yield();
+            return;
+        }
+        for (unsigned i = 0; i < spins; ++i) cpuRelax();
+        spins *= 2;
+    }
+
+private:
+    static constexpr unsigned kMaxSpins = 1024;
+    unsigned spins = 1;
+};
+
+// The common interface: what std::lock_guard and std::unique_lock need
+template <typename L>
+concept Lockable = requires(L& l) {
+    l.lock();
+    l.unlock();
+    { l.try_lock() } -> std::convertible_to<bool>;
+};
+
+// A Lockable that also has a shared (reader) mode, like std::shared_mutex
+template <typename L>
+concept SharedLockable = Lockable<L> && requires(L& l) {
+    l.lock_shared();
+    l.unlock_shared();
+    { l.try_lock_shared() } -> std::convertible_to<bool>;
+};
+
+// Test-and-test-and-set: waiters spin on a plain load, which stays in their
+// own cache, and only try the exchange once the lock looks free
+class TtasSpinLock {
+public:
+    void lock() {
+        Backoff backoff;
+        while (locked.exchange(true, std::memory_order_acquire)) {
+            do {
+                backoff.pause();
+            } while (locked.load(std::memory_order_relaxed));
+        }
+    }
+
+    bool try_lock() {
+        return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() { locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> locked{false};
+};
+
+// Threads take a ticket and wait for it to be served: first come, first
+// served, where TtasSpinLock lets whoever is fastest win
+class TicketLock {
+public:
+    void lock() {
+        const std::uint32_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+        const unsigned budget = spinBudget();
+        for (unsigned spent = 0;;) {
+            const std::uint32_t current = serving.load(std::memory_order_acquire);
+            if (current == ticket) return;
+            if (spent < budget) {
+                // Proportional backoff: the further back in line, the longer
+                const std::uint32_t n = (ticket - current) * 32;
+                for (std::uint32_t i = 0; i < n; ++i) cpuRelax();
+                spent += n;
+            } else {
+                // Only the next ticket may take the lock; if that thread is
+                // not running, yielding to the others does not help. Sleep
+                // until `serving` moves instead.
+                serving.wait(current, std::memory_order_acquire);
+            }
+        }
+    }
+
+    bool try_lock() {
+        std::uint32_t current = serving.load(std::memory_order_acquire);
+        std::uint32_t expected = current;
+        return next.compare_exchange_strong(expected, current + 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        // Only the holder writes `serving`
+        serving.store(serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        serving.notify_all(); // No system call unless someone sleeps
+    }
+
+private:
+    alignas(64) std::atomic<std::uint32_t> next{0};
+    alignas(64) std::atomic<std::uint32_t> serving{0};
+};
+
+// Mellor-Crummey & Scott queue lock: waiters form a linked list and each
+// spins on a flag in its own node, so a release touches one other core's
+// cache line instead of every waiter's.
+//
+// lock(node) / unlock(node) take the node explicitly (it must stay alive
+// until unlock); lock() / unlock() take one from a per-thread pool, which
+// makes McsLock a drop-in Lockable.
+class McsLock {
+public:
+    struct alignas(64) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<std::uint32_t> waiting{0};
+    };
+
+    void lock(Node& node) {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.waiting.store(1, std::memory_order_relaxed);
+        Node* prev = tail.exchange(&node, std::memory_order_acq_rel);
+        if (prev == nullptr) return; // Queue was empty
+        prev->next.store(&node, std::memory_order_release);
+        const unsigned budget = spinBudget();
+        for (unsigned spent = 0; node.waiting.load(std::memory_order_acquire); ++spent) {
+            if (spent < budget) {
+                cpuRelax();
+            } else {
+                node.waiting.wait(1, std::memory_order_acquire); // As in TicketLock
+            }
+        }
+    }
+
+    bool try_lock(Node& node) {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        Node* expected = nullptr;
+        return tail.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock(Node& node) {
+        Node* successor = node.next.load(std::memory_order_acquire);
+        if (successor == nullptr) {
+            Node* expected = &node;
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+                return; // Nobody waiting
+            }
+            // A thread joined the queue but has not linked itself in yet
+            Backoff backoff;
+            while ((successor = node.next.load(std::memory_order_acquire)) == nullptr) backoff.pause();
+        }
+        successor->waiting.store(0, std::memory_order_release);
+        // The wake-up only passes the node's address to the kernel, so it
+        // is harmless if the successor has already gone on without sleeping
+        successor->waiting.notify_one();
+    }
+
+    void lock() {
+        Node* node = takeNode();
+        lock(*node);
+        holder = node;
+    }
+
+    bool try_lock() {
+        Node* node = takeNode();
+        if (!try_lock(*node)) {
+            returnNode(node);
+            return false;
+        }
+        holder = node;
+        return true;
+    }
+
+    void unlock() {
+        Node* node = holder; // Read before the release: the next holder overwrites it
+        unlock(*node);
+        returnNode(node);
+    }
+
+private:
+    // Nodes of the locks this thread holds (or is queued on) through lock()
+    struct NodePool {
+        std::vector<std::unique_ptr<Node>> nodes;
+        std::vector<Node*> free;
+    };
+
+    static NodePool& pool() {
+        thread_local NodePool p;
+        return p;
+    }
+
+    static Node* takeNode() {
+        NodePool& p = pool();
+        if (p.free.empty()) {
+            p.nodes.push_back(std::make_unique<Node>());
+            return p.nodes.back().get();
+        }
+        Node* node = p.free.back();
+        p.free.pop_back();
+        return node;
+    }
+
+    static void returnNode(Node* node) { pool().free.push_back(node); }
+
+    alignas(64) std::atomic<Node*> tail{nullptr};
+    alignas(64) Node* holder = nullptr; // Only the holder reads or writes it
+};
+
+// Spins for a short while (the holder is probably about to release), then
+// sleeps on a futex through std::atomic::wait. Drepper's three-state mutex
+// ("Futexes Are Tricky"): unlock() only makes a system call when someone
+// is asleep.
+class AdaptiveMutex {
+public:
+    void lock() {
+        for (unsigned i = 0, spins = spinBudget() ? kSpins : 0; i < spins; ++i) {
+            std::uint32_t expected = Free;
+            if (state.load(std::memory_order_relaxed) == Free &&
+                state.compare_exchange_weak(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            cpuRelax();
+        }
+        // Whoever gets it now may have sleepers behind it: mark it Contended
+        while (state.exchange(Contended, std::memory_order_acquire) != Free) {
+            state.wait(Contended, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_lock() {
+        std::uint32_t expected = Free;
+        return state.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        if (state.exchange(Free, std::memory_order_release) == Contended) state.notify_one();
+    }
+
+private:
+    static constexpr unsigned kSpins = 100;
+    enum : std::uint32_t { Free, Locked, Contended };
+
+    std::atomic<std::uint32_t> state{Free};
+};
+
+// Reader-writer spin lock: any number of readers, or one writer. Writers
+// have priority: once one is waiting, new readers hold back, so a steady
+// stream of getBalance() calls cannot starve a deposit().
+class RwSpinLock {
+public:
+    void lock_shared() {
+        Backoff backoff;
+        for (;;) {
+            std::uint32_t s = state.load(std::memory_order_relaxed);
+            if ((s & (Writer | WriterWaiting)) == 0 &&
+                state.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            backoff.pause();
+        }
+    }
+
+    bool try_lock_shared() {
+        std::uint32_t s = state.load(std::memory_order_relaxed);
+        return (s & (Writer | WriterWaiting)) == 0 &&
+               state.compare_exchange_strong(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock_shared() { state.fetch_sub(1, std::memory_order_release); }
+
+    void lock() {
+        Backoff backoff;
+        for (;;) {
+            std::uint32_t s = state.load(std::memory_order_relaxed);
+            // No readers and no writer: take it (and clear WriterWaiting;
+            // other waiting writers set it again)
+            if ((s & ~WriterWaiting) == 0 &&
+                state.compare_exchange_weak(s, Writer, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+            if ((s & WriterWaiting) == 0) state.fetch_or(WriterWaiting, std::memory_order_relaxed);
+            backoff.pause();
+        }
+    }
+
+    bool try_lock() {
+        std::uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, Writer, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() { state.fetch_and(~Writer, std::memory_order_release); }
+
+private:
+    enum : std::uint32_t {
+        Writer = 1u << 31,
+        WriterWaiting = 1u << 30, // Below: the number of readers
+    };
+
+    std::atomic<std::uint32_t> state{0};
+};
+
+static_assert(Lockable<std::mutex> && Lockable<TtasSpinLock> && Lockable<TicketLock> && Lockable<McsLock> &&
+              Lockable<AdaptiveMutex>);
+static_assert(SharedLockable<std::shared_mutex> && SharedLockable<RwSpinLock>);
+
+// A value that can only be reached with its lock held. read() takes the
+// lock in shared mode when the lock has one, so readers run in parallel.
+template <typename T, Lockable Lock = std::mutex>
+class Guarded {
+public:
+    template <typename... Args>
+    explicit Guarded(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    Guarded(const Guarded&) = delete;
+    Guarded& operator=(const Guarded&) = delete;
+
+    // fn(T&) with the lock held exclusively
+    template <typename Fn>
+    decltype(auto) write(Fn&& fn) {
+        std::lock_guard<Lock> guard(lock);
+        return std::forward<Fn>(fn)(value);
+    }
+
+    // fn(const T&) with the lock held shared (or exclusively)
+    template <typename Fn>
+    decltype(auto) read(Fn&& fn) const {
+        if constexpr (SharedLockable<Lock>) {
+            std::shared_lock<Lock> guard(lock);
+            return std::forward<Fn>(fn)(std::as_const(value));
+        } else {
+            std::lock_guard<Lock> guard(lock);
+            return std::forward<Fn>(fn)(std::as_const(value));
+        }
+    }
+
+private:
+    mutable Lock lock;
+    T value;
+};
+
+} // namespace oops
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OOPS_HAVE_MMAP 1
+#endif
+
+namespace oops {
+
+// Read-only view of a whole file. Uses mmap where available, otherwise
+// reads the file into memory.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(OOPS_HAVE_MMAP)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("MappedFile: cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot stat " + path);
+        }
+        length = std::size_t(st.st_size);
+        if (length > 0) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: mmap failed for " + path);
+            }
+            ::madvise(p, length, MADV_SEQUENTIAL);
+            mapping = static_cast<const char*>(p);
+        }
+        ::close(fd); // The mapping stays valid
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("MappedFile: cannot open " + path);
+        fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        mapping = fallback.data();
+        length = fallback.size();
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(OOPS_HAVE_MMAP)
+        if (mapping != nullptr) ::munmap(const_cast<char*>(mapping), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view contents() const { return std::string_view(mapping, length); }
+
+private:
+    const char* mapping = nullptr;
+    std::size_t length = 0;
+#if !defined(OOPS_HAVE_MMAP)
+    std::vector<char> fallback;
+#endif
+};
+
+} // namespace oops
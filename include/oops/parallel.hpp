@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "thread_pool.hpp"
+
+/**
+ * Minimal fork/join helpers for the bulk operations (loaders, stores).
+ * The parts run as tasks on ThreadPool::global(); the calling thread runs
+ * part 0 itself, then helps with the rest.
+ */
+
+namespace oops {
+
+// Runs fn(i) for i in [0, count) in parallel
+template <typename Fn>
+void parallelFor(std::size_t count, Fn fn) {
+    if (count == 0) return;
+    TaskGroup group;
+    for (std::size_t i = 1; i < count; ++i) {
+        group.run([&fn, i] { fn(i); });
+    }
+    fn(0);
+    group.wait();
+}
+
+// Splits [0, size) into at most `parts` contiguous ranges whose boundaries
+// are multiples of `grain`, and runs fn(part, begin, end) on each in parallel
+template <typename Fn>
+std::size_t parallelRanges(std::size_t size, std::size_t parts, std::size_t grain, Fn fn) {
+    std::size_t blocks = (size + grain - 1) / grain;
+    parts = std::max<std::size_t>(1, std::min(parts, blocks));
+    parallelFor(parts, [&](std::size_t p) {
+        std::size_t begin = std::min(size, blocks * p / parts * grain);
+        std::size_t end = std::min(size, blocks * (p + 1) / parts * grain);
+        fn(p, begin, end);
+    });
+    return parts;
+}
+
+} // namespace oops
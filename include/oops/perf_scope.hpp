@@ -0,0 +1,296 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * PerfScope - hardware performance counters around a region (Linux)
+ *
+ * Wall time says that a loop got slower; the counters say why: more
+ * instructions, a lower IPC, cache misses, branch mispredictions.
+ *
+ *     oops::PerfCounters counters; // Opens the events once (a few syscalls)
+ *     oops::PerfCounts counts;
+ *     {
+ *         oops::PerfScope scope(counters, counts);
+ *         hotLoop();
+ *     }
+ *     if (counts.has(oops::PerfEvent::Cycles)) std::cout << "IPC " << counts.ipc() << "\n";
+ *
+ * Only the calling thread is counted, in user space only. Scopes nest: the
+ * counters are never reset, each scope subtracts the values it saw at its
+ * start. Cycles and instructions are opened as one group, so the kernel
+ * counts them over the same time window and ipc() divides like by like. The
+ * other events are opened on their own, so the ones the machine supports
+ * still work when others do not: virtual machines often expose no hardware
+ * counters at all, and perf_event_paranoid may forbid them. Unavailable
+ * events report has() == false; reason() says why. Setting OOPS_PERF=0 in
+ * the environment turns all of them off.
+ */
+
+namespace oops {
+
+enum class PerfEvent : std::uint8_t {
+    Cycles,
+    Instructions,
+    L1dMisses,       // L1 data cache read misses
+    LlcMisses,       // Last-level cache misses
+    BranchMisses,    // Mispredicted branches
+    ContextSwitches, // Software event: available even without a PMU
+    Count            // Number of events, not an event
+};
+
+constexpr std::size_t kPerfEvents = std::size_t(PerfEvent::Count);
+
+constexpr std::string_view perfEventName(PerfEvent event) {
+    switch (event) {
+    case PerfEvent::Cycles: return "cycles";
+    case PerfEvent::Instructions: return "instructions";
+    case PerfEvent::L1dMisses: return "L1d_misses";
+    case PerfEvent::LlcMisses: return "LLC_misses";
+    case PerfEvent::BranchMisses: return "branch_misses";
+    case PerfEvent::ContextSwitches: return "ctx_switches";
+    case PerfEvent::Count: break;
+    }
+    return "unknown";
+}
+
+// Counter values of one or more regions
+struct PerfCounts {
+    std::array<std::uint64_t, kPerfEvents> values{};
+    std::array<bool, kPerfEvents> valid{};
+
+    bool has(PerfEvent event) const { return valid[std::size_t(event)]; }
+    std::uint64_t operator[](PerfEvent event) const { return values[std::size_t(event)]; }
+
+    // Instructions per cycle; 0 if either counter is missing
+    double ipc() const {
+        if (!has(PerfEvent::Instructions) || !has(PerfEvent::Cycles) || (*this)[PerfEvent::Cycles] == 0) return 0.0;
+        return double((*this)[PerfEvent::Instructions]) / double((*this)[PerfEvent::Cycles]);
+    }
+
+    PerfCounts& operator+=(const PerfCounts& other) {
+        for (std::size_t i = 0; i < kPerfEvents; ++i) {
+            values[i] += other.values[i];
+            valid[i] = valid[i] || other.valid[i];
+        }
+        return *this;
+    }
+};
+
+// Raw counter values at the start of a region, for PerfCounters::stop()
+struct PerfMark {
+    std::array<std::uint64_t, kPerfEvents> values{};
+    std::array<std::uint64_t, kPerfEvents> enabled{}; // Time the event was enabled (ns)
+    std::array<std::uint64_t, kPerfEvents> running{}; // Time it was actually counting (ns)
+    std::array<bool, kPerfEvents> valid{};
+};
+
+// The opened events of the calling thread. Not thread-safe: one per thread.
+class PerfCounters {
+public:
+    PerfCounters() {
+        fds.fill(-1);
+        for (std::size_t i = 0; i < kPerfEvents; ++i) {
+            leader[i] = i;
+            slot[i] = 0;
+        }
+        if (const char* env = std::getenv("OOPS_PERF"); env && std::string_view(env) == "0") {
+            why = "disabled by OOPS_PERF=0";
+            return;
+        }
+#ifdef __linux__
+        for (std::size_t i = 0; i < kPerfEvents; ++i) {
+            // Instructions joins the cycles group when there is one
+            const std::size_t lead = PerfEvent(i) == PerfEvent::Instructions ? std::size_t(PerfEvent::Cycles) : i;
+            if (lead != i && fds[lead] >= 0) {
+                fds[i] = open(PerfEvent(i), fds[lead]);
+                if (fds[i] >= 0) {
+                    leader[i] = lead;
+                    slot[i] = ++members[lead];
+                }
+            }
+            if (fds[i] < 0) fds[i] = open(PerfEvent(i), -1);
+            if (fds[i] < 0 && why.empty()) {
+                why = std::string(perfEventName(PerfEvent(i))) + ": " + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) why += " (see /proc/sys/kernel/perf_event_paranoid)";
+                if (errno == ENOENT || errno == EOPNOTSUPP) why += " (no such counter on this machine)";
+            }
+        }
+#else
+        why = "perf_event_open is Linux-only";
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(PerfEvent event) const { return fds[std::size_t(event)] >= 0; }
+
+    // True if at least one event can be counted
+    bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    // Why the first unavailable event could not be opened ("" if all were)
+    const std::string& reason() const { return why; }
+
+    // Starts the events (if no region is running yet) and returns their
+    // current values: pass them to stop() at the end of the region
+    PerfMark start() {
+#ifdef __linux__
+        if (depth++ == 0) {
+            for (std::size_t i = 0; i < kPerfEvents; ++i) {
+                if (fds[i] >= 0 && leader[i] == i) ::ioctl(fds[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+#endif
+        return read();
+    }
+
+    // Counts since `begin`; stops the events when the outermost region ends
+    PerfCounts stop(const PerfMark& begin) {
+        const PerfMark end = read();
+        PerfCounts counts;
+        for (std::size_t i = 0; i < kPerfEvents; ++i) {
+            if (!begin.valid[i] || !end.valid[i]) continue;
+            const std::uint64_t value = end.values[i] - begin.values[i];
+            const std::uint64_t enabled = end.enabled[i] - begin.enabled[i];
+            const std::uint64_t running = end.running[i] - begin.running[i];
+            if (running == 0) continue;
+            // More events than hardware counters: the kernel time-shares
+            // them, so scale up to the whole region
+            counts.values[i] = running < enabled ? std::uint64_t(double(value) * enabled / running) : value;
+            counts.valid[i] = true;
+        }
+#ifdef __linux__
+        if (depth > 0 && --depth == 0) {
+            for (std::size_t i = 0; i < kPerfEvents; ++i) {
+                if (fds[i] >= 0 && leader[i] == i) ::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+#endif
+        return counts;
+    }
+
+private:
+    // Current raw values: one read per group, so the members of a group
+    // share one set of times
+    PerfMark read() const {
+        PerfMark mark;
+#ifdef __linux__
+        for (std::size_t i = 0; i < kPerfEvents; ++i) {
+            if (fds[i] < 0 || leader[i] != i) continue;
+            // nr, time enabled, time running, then one value per member
+            std::uint64_t data[3 + kPerfEvents];
+            const ssize_t expected = ssize_t((3 + members[i] + 1) * sizeof(std::uint64_t));
+            if (::read(fds[i], data, sizeof(data)) != expected) continue;
+            for (std::size_t e = 0; e < kPerfEvents; ++e) {
+                if (fds[e] < 0 || leader[e] != i) continue;
+                mark.values[e] = data[3 + slot[e]];
+                mark.enabled[e] = data[1];
+                mark.running[e] = data[2];
+                mark.valid[e] = true;
+            }
+        }
+#endif
+        return mark;
+    }
+
+#ifdef __linux__
+    // groupFd -1 opens a group leader (or a group of one)
+    static int open(PerfEvent event, int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = groupFd < 0; // Members follow their leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        constexpr std::uint64_t cacheReadMiss =
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        switch (event) {
+        case PerfEvent::Cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::Instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::L1dMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | cacheReadMiss;
+            break;
+        case PerfEvent::LlcMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfEvent::BranchMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::ContextSwitches:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+            attr.exclude_kernel = 0; // Switches happen in the kernel
+            break;
+        case PerfEvent::Count:
+            return -1;
+        }
+        // pid 0, cpu -1: this thread, on whichever CPU it runs
+        return int(::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+#endif
+
+    std::array<int, kPerfEvents> fds;
+    std::array<std::size_t, kPerfEvents> leader;    // Event whose fd reads this one's group
+    std::array<std::size_t, kPerfEvents> slot;      // Position in the group's read (leader: 0)
+    std::array<std::size_t, kPerfEvents> members{}; // Per leader: events that joined it
+    unsigned depth = 0;                             // Regions currently running
+    std::string why;
+};
+
+// Counts a region: starts the counters on construction and adds their
+// values to `out` when it goes out of scope. Scopes may nest.
+class PerfScope {
+public:
+    PerfScope(PerfCounters& counters, PerfCounts& out) : counters(counters), out(out), begin(counters.start()) {}
+
+    ~PerfScope() { out += counters.stop(begin); }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfCounters& counters;
+    PerfCounts& out;
+    PerfMark begin;
+};
+
+} // namespace oops
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lock_order.hpp" // CheckedMutex
+#include "queues.hpp"
+
+/**
+ * Pipeline - producer/consumer stages connected by bounded queues
+ *
+ *     oops::Pipeline<Order> pipeline({.batch = 64});
+ *     pipeline.stage("parse", [](Order& o) { o.parse(); })
+ *             .stage("price", [](Order& o) { o.price(); }, 4);  // Four threads
+ *     pipeline.run([&](Order& o) { return feed.next(o); },     // Source: false when done
+ *                  [&](Order& o) { book.add(o); });            // Sink, on the calling thread
+ *
+ * The source runs on a thread of its own and each stage on its own threads
+ * (not the ThreadPool's: they wait on queues, which would starve the pool).
+ * Items travel in batches of up to `batch`, so the cost of a queue hand-off
+ * (and of waking the next stage) is paid once per batch, not once per item.
+ * With several threads in a stage, items leave it out of order.
+ *
+ * Each link gets the cheapest queue that is correct for it: SpscQueue
+ * between two single-threaded ends, BoundedMpmcQueue otherwise, and
+ * BlockingQueue everywhere with `lockFree = false` (threads sleep instead
+ * of spinning - better when there are more threads than cores).
+ *
+ * If a stage, the source or the sink throws, the items still in flight are
+ * dropped and run() rethrows the first exception once every thread is done.
+ */
+
+namespace oops {
+
+struct PipelineOptions {
+    std::size_t batch = 64;    // Items per queue hand-off
+    std::size_t capacity = 64; // Batches a link can hold
+    bool lockFree = true;      // false: BlockingQueue links
+};
+
+namespace detail {
+
+// A link between two stages, whichever queue it is
+template <typename Batch>
+class Channel {
+public:
+    virtual ~Channel() = default;
+    virtual void push(Batch&& batch) = 0;
+    virtual bool pop(Batch& batch) = 0; // False once closed and drained
+    virtual void close() = 0;
+};
+
+template <typename Batch, template <typename> class Queue>
+class QueueChannel final : public Channel<Batch> {
+public:
+    explicit QueueChannel(std::size_t capacity) : queue(capacity) {}
+
+    void push(Batch&& batch) override { queue.push(std::move(batch)); }
+    bool pop(Batch& batch) override { return queue.pop(batch); }
+    void close() override { queue.close(); }
+
+private:
+    Queue<Batch> queue;
+};
+
+// The first exception any thread of a run threw
+class PipelineFailure {
+public:
+    void record(std::exception_ptr e) {
+        std::lock_guard<CheckedMutex<>> lock(mtx);
+        if (!error) error = std::move(e);
+        flag.store(true, std::memory_order_release);
+    }
+
+    bool failed() const { return flag.load(std::memory_order_acquire); }
+
+    void rethrow() {
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    std::atomic<bool> flag{false};
+    CheckedMutex<> mtx{"PipelineFailure"};
+    std::exception_ptr error;
+};
+
+} // namespace detail
+
+// T must be default-constructible and movable
+template <typename T>
+class Pipeline {
+public:
+    using Source = std::function<bool(T&)>; // Fills in the next item; false when there are no more
+    using Step = std::function<void(T&)>;
+    using Sink = std::function<void(T&)>;
+
+    explicit Pipeline(PipelineOptions options = {}) : options(options) {
+        this->options.batch = std::max<std::size_t>(options.batch, 1);
+    }
+
+    Pipeline& stage(std::string name, Step step, unsigned threads = 1) {
+        stages.push_back({std::move(name), std::move(step), std::max(threads, 1u)});
+        return *this;
+    }
+
+    // e.g. "source -spsc-> parse -mpmc-> price x4 -mpmc-> sink"
+    std::string describe() const {
+        std::string text = "source";
+        for (std::size_t i = 0; i < stages.size(); ++i) {
+            text += std::string(" -") + linkKind(i) + "-> " + stages[i].name;
+            if (stages[i].threads > 1) text += " x" + std::to_string(stages[i].threads);
+        }
+        return text + " -" + linkKind(stages.size()) + "-> sink";
+    }
+
+    // Runs every item through the stages; returns how many reached the sink
+    std::size_t run(Source source, Sink sink) {
+        // links[i] feeds stages[i]; the last one feeds the sink
+        std::vector<std::unique_ptr<detail::Channel<Batch>>> links;
+        for (std::size_t i = 0; i <= stages.size(); ++i) links.push_back(makeLink(i));
+        std::vector<std::atomic<unsigned>> running(stages.size());
+        detail::PipelineFailure failure;
+
+        std::vector<std::thread> threads;
+        threads.emplace_back([&] { produce(source, *links[0], failure); });
+        for (std::size_t i = 0; i < stages.size(); ++i) {
+            running[i].store(stages[i].threads, std::memory_order_relaxed);
+            for (unsigned t = 0; t < stages[i].threads; ++t) {
+                threads.emplace_back([&, i] { work(stages[i], *links[i], *links[i + 1], running[i], failure); });
+            }
+        }
+
+        std::size_t delivered = 0;
+        Batch batch;
+        while (links.back()->pop(batch)) {
+            if (failure.failed()) continue; // Drain, so no stage is left waiting on a full link
+            try {
+                for (T& item : batch) {
+                    sink(item);
+                    ++delivered;
+                }
+            } catch (...) {
+                failure.record(std::current_exception());
+            }
+        }
+        for (std::thread& thread : threads) thread.join();
+        failure.rethrow();
+        return delivered;
+    }
+
+private:
+    using Batch = std::vector<T>;
+
+    struct Stage {
+        std::string name;
+        Step step;
+        unsigned threads;
+    };
+
+    unsigned producersOf(std::size_t link) const { return link == 0 ? 1 : stages[link - 1].threads; }
+    unsigned consumersOf(std::size_t link) const { return link == stages.size() ? 1 : stages[link].threads; }
+
+    const char* linkKind(std::size_t link) const {
+        if (!options.lockFree) return "blocking";
+        return producersOf(link) == 1 && consumersOf(link) == 1 ? "spsc" : "mpmc";
+    }
+
+    std::unique_ptr<detail::Channel<Batch>> makeLink(std::size_t link) const {
+        if (!options.lockFree) return std::make_unique<detail::QueueChannel<Batch, BlockingQueue>>(options.capacity);
+        if (producersOf(link) == 1 && consumersOf(link) == 1) {
+            return std::make_unique<detail::QueueChannel<Batch, SpscQueue>>(options.capacity);
+        }
+        return std::make_unique<detail::QueueChannel<Batch, BoundedMpmcQueue>>(options.capacity);
+    }
+
+    void produce(Source& source, detail::Channel<Batch>& out, detail::PipelineFailure& failure) const {
+        try {
+            Batch batch;
+            batch.reserve(options.batch);
+            T item;
+            while (!failure.failed() && source(item)) {
+                batch.push_back(std::move(item));
+                if (batch.size() == options.batch) {
+                    out.push(std::move(batch));
+                    batch = Batch();
+                    batch.reserve(options.batch);
+                }
+            }
+            if (!batch.empty()) out.push(std::move(batch));
+        } catch (...) {
+            failure.record(std::current_exception());
+        }
+        out.close();
+    }
+
+    // One thread of a stage. The last of them to finish closes the next link.
+    static void work(const Stage& stage, detail::Channel<Batch>& in, detail::Channel<Batch>& out,
+                     std::atomic<unsigned>& running, detail::PipelineFailure& failure) {
+        Batch batch;
+        while (in.pop(batch)) {
+            if (failure.failed()) continue;
+            try {
+                for (T& item : batch) stage.step(item);
+                out.push(std::move(batch));
+            } catch (...) {
+                failure.record(std::current_exception());
+            }
+        }
+        // acq_rel: the closing thread sees every other thread's pushes
+        if (running.fetch_sub(1, std::memory_order_acq_rel) == 1) out.close();
+    }
+
+    PipelineOptions options;
+    std::vector<Stage> stages;
+};
+
+} // namespace oops
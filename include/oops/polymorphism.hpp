@@ -0,0 +1,63 @@
+#pragma once
+
+#include <iostream>
+#include <ostream>
+
+#include "calculator.hpp" // Compile-time polymorphism: Calculator::add overloads
+
+namespace oops {
+
+class Animal {
+public:
+    virtual ~Animal() = default; // Deleting through Animal* must reach ~Dog
+
+    // Virtual function for Run-time Polymorphism
+    virtual void makeSound() {
+        std::cout << "Animal makes a sound" << std::endl;
+    }
+};
+
+// What a dog does when it makes a sound. The virtual Dog below and the CRTP
+// Dog of static_polymorphism.hpp both forward to it, so the two kinds of
+// call run identical code. Barks are counted, and printed to `out` unless
+// it is nullptr (hot loops).
+class DogImpl {
+public:
+    explicit DogImpl(std::ostream* out = &std::cout) : out(out) {}
+
+    void makeSound() {
+        ++barks;
+        if (out) *out << "Dog barks" << std::endl;
+    }
+
+    long soundCount() const { return barks; }
+
+private:
+    std::ostream* out;
+    long barks = 0;
+};
+
+// 'final': nothing can derive from Dog, so when the static type is Dog the
+// compiler knows exactly which makeSound() runs and calls it directly.
+class Dog final : public Animal {
+public:
+    explicit Dog(std::ostream* out = &std::cout) : impl(out) {}
+
+    // Run-time Polymorphism (Method Overriding)
+    void makeSound() override {
+        impl.makeSound();
+    }
+
+    long soundCount() const { return impl.soundCount(); }
+
+private:
+    DogImpl impl;
+};
+
+// Hot path: static type is Dog (final) -> direct call, no vtable lookup.
+// tools/check_devirtualization.sh verifies this in the generated code.
+inline void makeSoundDirect(Dog& dog) {
+    dog.makeSound();
+}
+
+} // namespace oops
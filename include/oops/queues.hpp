@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "locks.hpp" // Backoff, spinBudget
+
+/**
+ * Bounded queues for handing work between threads
+ *
+ *     oops::BoundedMpmcQueue<Order> queue(1024);  // Any number of producers and consumers
+ *     queue.push(order);                          // Waits while full
+ *     Order next;
+ *     while (queue.pop(next)) handle(next);       // Waits while empty; false once closed and drained
+ *     queue.close();                              // From the producer side, when it is done
+ *
+ * | Queue            | Threads                  | Waiting                                  |
+ * | ---------------- | ------------------------ | ---------------------------------------- |
+ * | BoundedMpmcQueue | Many to many (lock-free) | Spins with backoff, then yields          |
+ * | SpscQueue        | One to one (wait-free)   | Spins with backoff, then yields          |
+ * | BlockingQueue    | Many to many (mutex)     | Sleeps on a condition_variable           |
+ *
+ * All three have the same interface: tryPush / tryPop never wait; push /
+ * pop wait; close() ends the stream. The lock-free ones trade CPU time for
+ * latency: a waiting thread keeps polling instead of sleeping (on a single
+ * CPU it yields right away, since spinning there only delays the thread it
+ * waits for).
+ */
+
+namespace oops {
+
+namespace detail {
+
+inline std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t power = 1;
+    while (power < n) power <<= 1;
+    return power;
+}
+
+// Storage for one T, constructed and destroyed by hand
+template <typename T>
+struct Uninitialized {
+    alignas(T) unsigned char bytes[sizeof(T)];
+
+    T* get() { return std::launder(reinterpret_cast<T*>(bytes)); }
+};
+
+// push / pop / close for a queue with tryPush / tryPop, by polling
+template <typename Queue>
+class PollingWait {
+public:
+    // Waits while the queue is full
+    template <typename U>
+    void push(U&& value) {
+        Backoff backoff;
+        while (!self().tryPush(std::forward<U>(value))) idle(backoff); // tryPush moves only on success
+    }
+
+    // Waits while the queue is empty. False once it is closed and empty.
+    template <typename T>
+    bool pop(T& out) {
+        Backoff backoff;
+        for (;;) {
+            if (self().tryPop(out)) return true;
+            // Pushes made before close() are visible once closed is
+            if (closedFlag.load(std::memory_order_acquire)) return self().tryPop(out);
+            idle(backoff);
+        }
+    }
+
+    // No more pushes: pop() returns false once the queue is drained
+    void close() { closedFlag.store(true, std::memory_order_release); }
+
+    bool closed() const { return closedFlag.load(std::memory_order_acquire); }
+
+private:
+    Queue& self() { return static_cast<Queue&>(*this); }
+
+    // With one CPU, spinning only delays the thread we are waiting for
+    static void idle(Backoff& backoff) {
+        if (spinBudget() == 0) {
+            std::this_thread::yield();
+        } else {
+            backoff.pause();
+        }
+    }
+
+    std::atomic<bool> closedFlag{false};
+};
+
+} // namespace detail
+
+// Dmitry Vyukov's bounded MPMC queue. Each cell carries a sequence number
+// that says whose turn it is: a producer claims position p when the cell's
+// sequence is p, a consumer when it is p + 1. A push or pop is one CAS on
+// its end's position, and threads at different cells never share a cache
+// line: the cells are padded to one line each.
+//
+// Once a position is claimed there is no going back: a cell that is never
+// published stalls every thread behind it. So nothing may throw between the
+// CAS and the sequence store: T must move without throwing, and a push that
+// copies or converts with a throwing constructor builds the T first.
+template <typename T>
+class BoundedMpmcQueue : public detail::PollingWait<BoundedMpmcQueue<T>> {
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                  "BoundedMpmcQueue<T>: T must be nothrow move constructible and assignable");
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit BoundedMpmcQueue(std::size_t capacity)
+        : mask(detail::roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2)) - 1), cells(new Cell[mask + 1]) {
+        for (std::size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~BoundedMpmcQueue() {
+        const std::size_t end = enqueuePos.load(std::memory_order_relaxed);
+        for (std::size_t pos = dequeuePos.load(std::memory_order_relaxed); pos != end; ++pos) {
+            cells[pos & mask].storage.get()->~T();
+        }
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // False (and `value` untouched) if full
+    template <typename U>
+    bool tryPush(U&& value) {
+        if constexpr (!std::is_nothrow_constructible_v<T, U&&>) {
+            // Converting an rvalue would consume it even when the queue is full
+            static_assert(std::is_lvalue_reference_v<U>,
+                          "BoundedMpmcQueue::tryPush: convert to T first, the conversion may throw");
+            return tryPush(T(value)); // May throw here, before a cell is claimed
+        }
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = std::intptr_t(seq) - std::intptr_t(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // The cell still holds the item from one lap ago
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+        ::new (cell->storage.bytes) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release); // Hands the cell to consumers
+        return true;
+    }
+
+    // False if empty
+    bool tryPop(T& out) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = std::intptr_t(seq) - std::intptr_t(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Not written yet
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T* item = cell->storage.get();
+        out = std::move(*item);
+        item->~T();
+        cell->sequence.store(pos + mask + 1, std::memory_order_release); // Free for the next lap
+        return true;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence;
+        detail::Uninitialized<T> storage;
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos{0};
+};
+
+// Single-producer single-consumer ring. Each side owns its index and keeps
+// a cached copy of the other's, so it reads the shared one (a cache miss)
+// only when the ring looks full or empty.
+template <typename T>
+class SpscQueue : public detail::PollingWait<SpscQueue<T>> {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(std::size_t capacity)
+        : mask(detail::roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2)) - 1),
+          slots(new detail::Uninitialized<T>[mask + 1]) {}
+
+    ~SpscQueue() {
+        for (std::size_t i = head.load(std::memory_order_relaxed); i != tail.load(std::memory_order_relaxed); ++i) {
+            slots[i & mask].get()->~T();
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // Producer thread only. False (and `value` untouched) if full.
+    template <typename U>
+    bool tryPush(U&& value) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache > mask) {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache > mask) return false;
+        }
+        ::new (slots[t & mask].bytes) T(std::forward<U>(value));
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. False if empty.
+    bool tryPop(T& out) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache) return false;
+        }
+        T* item = slots[h & mask].get();
+        out = std::move(*item);
+        item->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    const std::size_t mask;
+    std::unique_ptr<detail::Uninitialized<T>[]> slots;
+    // Consumer's line: its index and what it last saw of the producer's
+    alignas(64) std::atomic<std::size_t> head{0};
+    std::size_t tailCache = 0;
+    // Producer's line
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::size_t headCache = 0;
+};
+
+// The classic: a std::deque under a mutex, with condition variables for
+// "not full" and "not empty". Waiting threads sleep instead of polling.
+template <typename T>
+class BlockingQueue {
+public:
+    explicit BlockingQueue(std::size_t capacity) : limit(std::max<std::size_t>(capacity, 1)) {}
+
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    std::size_t capacity() const { return limit; }
+
+    template <typename U>
+    bool tryPush(U&& value) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (items.size() >= limit) return false;
+            items.push_back(std::forward<U>(value));
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (items.empty()) return false;
+            out = std::move(items.front());
+            items.pop_front();
+        }
+        notFull.notify_one();
+        return true;
+    }
+
+    template <typename U>
+    void push(U&& value) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notFull.wait(lock, [this] { return items.size() < limit; });
+            items.push_back(std::forward<U>(value));
+        }
+        notEmpty.notify_one();
+    }
+
+    bool pop(T& out) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notEmpty.wait(lock, [this] { return !items.empty() || isClosed; });
+            if (items.empty()) return false; // Closed and drained
+            out = std::move(items.front());
+            items.pop_front();
+        }
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            isClosed = true;
+        }
+        notEmpty.notify_all();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return isClosed;
+    }
+
+private:
+    const std::size_t limit;
+    mutable std::mutex mtx;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<T> items;
+    bool isClosed = false;
+};
+
+} // namespace oops
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "record_schema.hpp"
+
+/**
+ * Zero-copy Record Files
+ *
+ * writeRecords() stores an array of objects as fixed-size records, built in
+ * memory and written with a single write:
+ *
+ *   RecordFileHeader | RecordFieldDesc[fieldCount] | records | string heap
+ *
+ * Numbers are stored inline; strings as (offset, length) into the heap.
+ * RecordFile<T> memory-maps the file and reads fields in place - nothing is
+ * deserialized until you ask for a whole object with load(i):
+ *
+ *     oops::RecordFile<Car> cars("cars.rec");
+ *     auto brand = cars.column<std::string_view>("brand");
+ *     brand[7];   // string_view straight into the mapping
+ *
+ * The file carries its own field table, so a reader finds each field by name
+ * and type: fields missing from an older file read as default values, fields
+ * unknown to an older reader are skipped. Little-endian only.
+ */
+
+namespace oops {
+
+struct RecordFileHeader {
+    char magic[8];       // "OOPSREC1"
+    char schema[32];     // Schema<T>::name, NUL padded
+    std::uint32_t version;
+    std::uint32_t fieldCount;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    std::uint64_t fieldsOffset;
+    std::uint64_t recordsOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+};
+
+struct RecordFieldDesc {
+    char name[32];
+    FieldType type;
+    std::uint8_t padding[3];
+    std::uint32_t offset; // Within a record
+};
+
+static_assert(sizeof(RecordFileHeader) == 96);
+static_assert(sizeof(RecordFieldDesc) == 40);
+
+namespace detail {
+
+inline constexpr char kRecordMagic[8] = {'O', 'O', 'P', 'S', 'R', 'E', 'C', '1'};
+
+inline std::uint64_t alignTo8(std::uint64_t n) { return (n + 7) & ~std::uint64_t(7); }
+
+inline void copyName(char (&dest)[32], std::string_view name) {
+    if (name.size() >= sizeof(dest)) throw std::length_error("record field name too long: " + std::string(name));
+    std::memset(dest, 0, sizeof(dest));
+    std::memcpy(dest, name.data(), name.size());
+}
+
+inline std::string_view nameOf(const char (&field)[32]) {
+    return std::string_view(field, strnlen(field, sizeof(field)));
+}
+
+// Field table of Schema<T>: natural alignment, declaration order
+template <typename T>
+std::vector<RecordFieldDesc> layout(std::uint32_t& recordSize) {
+    std::vector<RecordFieldDesc> descs;
+    std::uint32_t offset = 0;
+    std::apply([&](const auto&... field) {
+        ([&] {
+            RecordFieldDesc d{};
+            copyName(d.name, field.name);
+            d.type = field.type;
+            std::uint32_t size = fieldSize(field.type);
+            offset = (offset + size - 1) / size * size;
+            d.offset = offset;
+            offset += size;
+            descs.push_back(d);
+        }(), ...);
+    }, Schema<T>::fields());
+    recordSize = std::uint32_t(alignTo8(offset));
+    return descs;
+}
+
+} // namespace detail
+
+// Serializes `objects` to `path` with one write
+template <typename T>
+void writeRecords(const std::string& path, std::span<const T> objects) {
+    std::uint32_t recordSize = 0;
+    std::vector<RecordFieldDesc> descs = detail::layout<T>(recordSize);
+
+    RecordFileHeader header{};
+    std::memcpy(header.magic, detail::kRecordMagic, 8);
+    detail::copyName(header.schema, Schema<T>::name);
+    header.version = Schema<T>::version;
+    header.fieldCount = std::uint32_t(descs.size());
+    header.recordSize = recordSize;
+    header.count = objects.size();
+    header.fieldsOffset = sizeof(RecordFileHeader);
+    header.recordsOffset = detail::alignTo8(header.fieldsOffset + descs.size() * sizeof(RecordFieldDesc));
+    header.stringsOffset = header.recordsOffset + std::uint64_t(recordSize) * objects.size();
+
+    std::vector<char> buffer(header.stringsOffset);
+    std::string strings;
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        char* record = buffer.data() + header.recordsOffset + i * recordSize;
+        std::size_t f = 0;
+        std::apply([&](const auto&... field) {
+            ([&] {
+                using M = typename std::decay_t<decltype(field)>::Type;
+                char* at = record + descs[f++].offset;
+                const M& value = objects[i].*(field.ptr);
+                if constexpr (FieldCodec<M>::type == FieldType::String) {
+                    std::string_view text = value;
+                    // Offsets and lengths are u32
+                    if (strings.size() + text.size() > std::numeric_limits<std::uint32_t>::max()) {
+                        throw std::length_error("writeRecords: string heap exceeds 4 GiB");
+                    }
+                    std::uint32_t ref[2] = {std::uint32_t(strings.size()), std::uint32_t(text.size())};
+                    std::memcpy(at, ref, sizeof(ref));
+                    strings.append(text);
+                } else {
+                    std::memcpy(at, &value, sizeof(M));
+                }
+            }(), ...);
+        }, Schema<T>::fields());
+    }
+
+    header.stringsSize = strings.size();
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + header.fieldsOffset, descs.data(), descs.size() * sizeof(RecordFieldDesc));
+    buffer.insert(buffer.end(), strings.begin(), strings.end());
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.write(buffer.data(), std::streamsize(buffer.size()))) {
+        throw std::runtime_error("writeRecords: cannot write " + path);
+    }
+}
+
+// Read-only accessor for one field of every record. A field that the file
+// does not have reads as V{}.
+template <typename V>
+class RecordColumn {
+public:
+    RecordColumn(const char* records, std::size_t stride, std::int64_t offset,
+                 std::string_view strings)
+        : records(records), stride(stride), offset(offset), strings(strings) {}
+
+    V operator[](std::size_t i) const {
+        if (offset < 0) return V{};
+        const char* at = records + i * stride + offset;
+        if constexpr (std::is_same_v<V, std::string_view>) {
+            std::uint32_t ref[2];
+            std::memcpy(ref, at, sizeof(ref));
+            if (std::uint64_t(ref[0]) + ref[1] > strings.size()) {
+                throw std::out_of_range("RecordColumn: string outside the heap");
+            }
+            return strings.substr(ref[0], ref[1]);
+        } else {
+            V value;
+            std::memcpy(&value, at, sizeof(V));
+            return value;
+        }
+    }
+
+    bool present() const { return offset >= 0; }
+
+private:
+    const char* records;
+    std::size_t stride;
+    std::int64_t offset;
+    std::string_view strings;
+};
+
+template <typename T>
+class RecordFile {
+public:
+    explicit RecordFile(const std::string& path) : file(path) {
+        std::string_view data = file.contents();
+        if (data.size() < sizeof(header)) throw std::runtime_error("RecordFile: file too small: " + path);
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, detail::kRecordMagic, 8) != 0) {
+            throw std::runtime_error("RecordFile: not a record file: " + path);
+        }
+        if (detail::nameOf(header.schema) != Schema<T>::name) {
+            throw std::runtime_error("RecordFile: " + path + " holds " + std::string(detail::nameOf(header.schema)) +
+                                     " records, expected " + std::string(Schema<T>::name));
+        }
+        // Divisions and subtractions of ordered offsets: a corrupt header
+        // cannot wrap a product or a sum past these checks
+        const std::uint64_t fileSize = data.size();
+        if (header.fieldsOffset > fileSize ||
+            header.fieldCount > (fileSize - header.fieldsOffset) / sizeof(RecordFieldDesc) ||
+            header.recordsOffset > header.stringsOffset || header.stringsOffset > fileSize ||
+            (header.recordSize != 0 &&
+             header.count > (header.stringsOffset - header.recordsOffset) / header.recordSize) ||
+            (header.recordSize == 0 && header.count != 0) ||
+            header.stringsSize > fileSize - header.stringsOffset) {
+            throw std::runtime_error("RecordFile: truncated or corrupt: " + path);
+        }
+
+        fields.resize(header.fieldCount);
+        std::memcpy(fields.data(), data.data() + header.fieldsOffset, fields.size() * sizeof(RecordFieldDesc));
+        for (const RecordFieldDesc& f : fields) {
+            if (std::uint64_t(f.offset) + fieldSize(f.type) > header.recordSize) {
+                throw std::runtime_error("RecordFile: field outside record: " + path);
+            }
+        }
+        records = data.data() + header.recordsOffset;
+        strings = data.substr(header.stringsOffset, header.stringsSize);
+
+        // Where each field of Schema<T> sits in this file, looked up once for load()
+        std::apply([&](const auto&... field) { (schemaFields.push_back(indexOf(field.name)), ...); },
+                   Schema<T>::fields());
+    }
+
+    std::size_t size() const { return header.count; }
+    std::uint32_t version() const { return header.version; }
+
+    // V is std::int32_t, std::int64_t, double or std::string_view
+    template <typename V>
+    RecordColumn<V> column(std::string_view name) const {
+        return columnAt<V>(indexOf(name), name);
+    }
+
+    // Materialises record i as a T (the only step that copies)
+    T load(std::size_t i) const {
+        T object = blank();
+        std::size_t f = 0;
+        std::apply([&](const auto&... field) {
+            ([&] {
+                using M = typename std::decay_t<decltype(field)>::Type;
+                const std::int32_t index = schemaFields[f++];
+                if (index < 0) return;
+                if constexpr (FieldCodec<M>::type == FieldType::String) {
+                    object.*(field.ptr) = M(columnAt<std::string_view>(index, field.name)[i]);
+                } else {
+                    object.*(field.ptr) = columnAt<M>(index, field.name)[i];
+                }
+            }(), ...);
+        }, Schema<T>::fields());
+        return object;
+    }
+
+private:
+    static T blank() {
+        if constexpr (requires { Schema<T>::blank(); }) {
+            return Schema<T>::blank();
+        } else {
+            return T();
+        }
+    }
+
+    // Index into `fields`, or -1 when the file has no such field (older writer)
+    std::int32_t indexOf(std::string_view name) const {
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            if (detail::nameOf(fields[i].name) == name) return std::int32_t(i);
+        }
+        return -1;
+    }
+
+    template <typename V>
+    RecordColumn<V> columnAt(std::int32_t index, std::string_view name) const {
+        std::int64_t offset = -1;
+        if (index >= 0) {
+            const RecordFieldDesc& f = fields[std::size_t(index)];
+            if (f.type != FieldCodec<V>::type) {
+                throw std::runtime_error("RecordFile: type mismatch for field " + std::string(name));
+            }
+            offset = f.offset;
+        }
+        return RecordColumn<V>(records, header.recordSize, offset, strings);
+    }
+
+    MappedFile file;
+    RecordFileHeader header;
+    std::vector<RecordFieldDesc> fields;
+    std::vector<std::int32_t> schemaFields; // indexOf() of each Schema<T> field
+    const char* records = nullptr;
+    std::string_view strings;
+};
+
+} // namespace oops
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "string_interner.hpp"
+
+/**
+ * Record Schemas - a small, hand-written form of reflection
+ *
+ * A class opts into binary serialization (see record_file.hpp) by
+ * specialising Schema<T> next to its definition:
+ *
+ *     template <> struct Schema<Car> {
+ *         static constexpr std::string_view name = "Car";
+ *         static constexpr std::uint32_t version = 1;
+ *         static constexpr auto fields() {
+ *             return std::make_tuple(member("brand", &Car::brand), ...);
+ *         }
+ *     };
+ *
+ * Fields are matched by name when reading, so a new field can be added (and
+ * the version bumped) without breaking files written by older versions.
+ * Classes with private data declare `template <typename> friend struct
+ * oops::Schema;` so the descriptor may name their members.
+ */
+
+namespace oops {
+
+enum class FieldType : std::uint8_t { Int32 = 1, Int64 = 2, Float64 = 3, String = 4 };
+
+// Maps a C++ member type to its on-disk type
+template <typename M>
+struct FieldCodec;
+
+template <>
+struct FieldCodec<std::int32_t> {
+    static constexpr FieldType type = FieldType::Int32;
+};
+
+template <>
+struct FieldCodec<std::int64_t> {
+    static constexpr FieldType type = FieldType::Int64;
+};
+
+template <>
+struct FieldCodec<double> {
+    static constexpr FieldType type = FieldType::Float64;
+};
+
+template <>
+struct FieldCodec<std::string> {
+    static constexpr FieldType type = FieldType::String;
+};
+
+template <>
+struct FieldCodec<std::string_view> { // Read side: RecordFile::column<std::string_view>
+    static constexpr FieldType type = FieldType::String;
+};
+
+template <>
+struct FieldCodec<InternedString> {
+    static constexpr FieldType type = FieldType::String;
+};
+
+// Size of one value inside a record; strings are (u32 offset, u32 length)
+constexpr std::uint32_t fieldSize(FieldType type) {
+    return type == FieldType::Int32 ? 4 : 8;
+}
+
+// One serialized data member
+template <typename T, typename M>
+struct MemberField {
+    using Owner = T;
+    using Type = M;
+    static constexpr FieldType type = FieldCodec<M>::type;
+
+    std::string_view name;
+    M T::*ptr;
+};
+
+template <typename T, typename M>
+constexpr MemberField<T, M> member(std::string_view name, M T::*ptr) {
+    return {name, ptr};
+}
+
+// Specialised per class. Optionally provides `static T blank()` for classes
+// that are not default-constructible.
+template <typename T>
+struct Schema;
+
+} // namespace oops
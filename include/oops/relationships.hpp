@@ -0,0 +1,78 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Car is a name other modules use too, hence the namespace
+namespace oops::relationships {
+
+// 1. Association
+class Car {
+public:
+    std::string model;
+    // Sink argument: take by value, then move into the member.
+    // Callers passing a temporary pay one allocation (none for short strings).
+    Car(std::string m) : model(std::move(m)) {}
+};
+
+class Driver {
+public:
+    std::string name;
+    Driver(std::string n) : name(std::move(n)) {}
+
+    void drive(Car* car) { // Uses a pointer/reference to Car
+        std::cout << name << " is driving " << car->model << std::endl;
+    }
+};
+
+// 2. Aggregation (Weak ownership uses pointers)
+class Professor {
+public:
+    std::string name;
+    Professor(std::string n) : name(std::move(n)) {}
+};
+
+class University {
+public:
+    std::string name;
+    std::vector<Professor*> professors; // Holds pointers. Does NOT own memory strictly.
+
+    University(std::string n) : name(std::move(n)) {}
+
+    void addProfessor(Professor* p) {
+        professors.push_back(p);
+    }
+    // Destructor does NOT delete professors
+};
+
+// 3. Composition (Strong ownership)
+class Engine {
+public:
+    std::string type;
+    Engine(std::string t) : type(std::move(t)) {
+        std::cout << "  [Engine created]" << std::endl;
+    }
+    ~Engine() {
+        std::cout << "  [Engine destroyed]" << std::endl;
+    }
+};
+
+class Airplane {
+private:
+    Engine* engine; // Composition via pointer for explicit control, or object member
+public:
+    Airplane() {
+        std::cout << "Airplane created." << std::endl;
+        engine = new Engine("Jet Engine");
+    }
+
+    ~Airplane() {
+        // Airplane is responsible for destroying its parts
+        delete engine;
+        std::cout << "Airplane destroyed." << std::endl;
+    }
+};
+
+} // namespace oops::relationships
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "instance_counted.hpp" // Tracked<T> (opt-in instance statistics)
+
+namespace oops {
+
+// Class demonstrating Constructors, Destructors, and RAII
+class Resource : public Tracked<Resource> {
+private:
+    std::string name;
+    int* data; // Pointer to simulate dynamic resource management
+
+public:
+    // 1. Default Constructor
+    Resource() {
+        name = "Default Resource";
+        data = new int(0);
+        std::cout << "[Constructor] Default created: " << name << std::endl;
+    }
+
+    // 2. Parameterized Constructor
+    // Takes the string by value and moves it in: no second copy
+    Resource(std::string n) {
+        name = std::move(n);
+        data = new int(0);
+        std::cout << "[Constructor] Created: " << name << std::endl;
+    }
+
+    // 3. Member Initializer List (Preferred in C++)
+    Resource(std::string n, int value) : name(std::move(n)), data(new int(value)) {
+        std::cout << "[Constructor] Created with value: " << name << " (" << *data << ")" << std::endl;
+    }
+
+    // 4. Copy Constructor
+    // Essential when class manages raw pointers (Deep Copy)
+    Resource(const Resource& other) : Tracked<Resource>(other) {
+        name = other.name + " (Copy)";
+        data = new int(*other.data); // Deep copy of data
+        std::cout << "[Copy Constructor] Copied from: " << other.name << std::endl;
+    }
+
+    // 5. Move Constructor
+    // Takes over the other object's int instead of allocating; the source is
+    // left empty (data == nullptr) but still safe to destroy or assign to
+    Resource(Resource&& other) noexcept
+        : Tracked<Resource>(other), name(std::move(other.name)), data(std::exchange(other.data, nullptr)) {
+        std::cout << "[Move Constructor] Moved: " << name << std::endl;
+    }
+
+    // 6. Assignment (copy-and-swap)
+    // `other` is already a copy (or a move) of the right-hand side; swapping
+    // with it hands our old int to its destructor. Covers both copy and move
+    // assignment, and leaves *this untouched if the copy throws.
+    Resource& operator=(Resource other) noexcept {
+        swap(*this, other);
+        std::cout << "[Assignment] Now holds: " << name << std::endl;
+        return *this;
+    }
+
+    friend void swap(Resource& a, Resource& b) noexcept {
+        using std::swap;
+        swap(a.name, b.name);
+        swap(a.data, b.data);
+    }
+
+    // 7. Destructor
+    // Automatically called when object goes out of scope
+    ~Resource() {
+        std::cout << "[Destructor] Cleaning up: " << name << std::endl;
+        delete data; // Prevent memory leak (nullptr after a move: no-op)
+    }
+
+    void use() const {
+        if (!data) {
+            std::cout << "Using resource: " << name << " [moved from]" << std::endl;
+            return;
+        }
+        std::cout << "Using resource: " << name << " [Data: " << *data << "]" << std::endl;
+    }
+};
+
+} // namespace oops
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * Result - error codes instead of printing
+ *
+ * Validating setters and transactions return a Result rather than writing to
+ * std::cout. It is a small stand-in for C++23's std::expected<T, ErrorCode>:
+ * either a value or a one-byte error code, checked like a bool.
+ *
+ *     if (auto r = student.setAge(-5); !r) {
+ *         std::cout << errorMessage(r.error()) << "\n";
+ *     }
+ *
+ * Callers that only want totals hand results to an ErrorSink, which counts
+ * them per code (thread-safe) and can print a summary at the end. Result is
+ * [[nodiscard]]: dropping one is a compiler warning; write `(void)` to mean it.
+ */
+
+namespace oops {
+
+enum class ErrorCode : std::uint8_t {
+    None = 0,
+    InvalidAge,        // Student::setAge: age <= 0
+    InvalidAmount,     // BankAccount: amount <= 0
+    InsufficientFunds, // BankAccount::withdraw: amount > balance
+    Count              // Number of codes, not an error
+};
+
+constexpr std::string_view errorMessage(ErrorCode code) {
+    switch (code) {
+    case ErrorCode::None: return "No error";
+    case ErrorCode::InvalidAge: return "Age cannot be negative or zero.";
+    case ErrorCode::InvalidAmount: return "Amount must be positive.";
+    case ErrorCode::InsufficientFunds: return "Insufficient funds.";
+    case ErrorCode::Count: break;
+    }
+    return "Unknown error";
+}
+
+class BadResultAccess : public std::logic_error {
+public:
+    explicit BadResultAccess(ErrorCode code)
+        : std::logic_error(std::string(errorMessage(code))), code(code) {}
+
+    ErrorCode error() const { return code; }
+
+private:
+    ErrorCode code;
+};
+
+// Error half of a Result, so `return Unexpected(code);` reads like std::unexpected
+struct Unexpected {
+    constexpr explicit Unexpected(ErrorCode code) : code(code) {}
+    ErrorCode code;
+};
+
+// A T, or the ErrorCode explaining why there is none
+template <typename T = void>
+class [[nodiscard]] Result {
+public:
+    constexpr Result(T value) : stored(std::move(value)) {}
+    constexpr Result(Unexpected e) : code(e.code) {}
+
+    constexpr bool hasValue() const { return code == ErrorCode::None; }
+    constexpr explicit operator bool() const { return hasValue(); }
+    constexpr ErrorCode error() const { return code; }
+
+    constexpr const T& value() const {
+        if (!hasValue()) throw BadResultAccess(code);
+        return stored;
+    }
+
+    constexpr T valueOr(T fallback) const { return hasValue() ? stored : fallback; }
+
+private:
+    T stored{};
+    ErrorCode code = ErrorCode::None;
+};
+
+// Success or an error code: one byte
+template <>
+class [[nodiscard]] Result<void> {
+public:
+    constexpr Result() = default;
+    constexpr Result(Unexpected e) : code(e.code) {}
+
+    constexpr bool hasValue() const { return code == ErrorCode::None; }
+    constexpr explicit operator bool() const { return hasValue(); }
+    constexpr ErrorCode error() const { return code; }
+
+    void value() const {
+        if (!hasValue()) throw BadResultAccess(code);
+    }
+
+private:
+    ErrorCode code = ErrorCode::None;
+};
+
+static_assert(sizeof(Result<>) == 1);
+
+// Counts failed results per error code. Safe to share between threads.
+class ErrorSink {
+public:
+    // Records r if it is an error, and passes it through
+    template <typename T>
+    const Result<T>& check(const Result<T>& r) {
+        if (!r) record(r.error());
+        return r;
+    }
+
+    void record(ErrorCode code) {
+        counts[std::size_t(code)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count(ErrorCode code) const {
+        return counts[std::size_t(code)].load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t total() const {
+        std::uint64_t sum = 0;
+        for (const auto& c : counts) sum += c.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    // One line per error code that occurred
+    void report(std::ostream& out) const {
+        for (std::size_t i = 1; i < counts.size(); ++i) {
+            if (std::uint64_t n = counts[i].load(std::memory_order_relaxed)) {
+                out << n << " x " << errorMessage(ErrorCode(i)) << "\n";
+            }
+        }
+    }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, std::size_t(ErrorCode::Count)> counts{};
+};
+
+} // namespace oops
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ostream>
+#include <utility>
+
+#include "polymorphism.hpp" // Animal, DogImpl
+
+/**
+ * Static Polymorphism (CRTP)
+ *
+ * The Curiously Recurring Template Pattern lets the base class call the
+ * derived implementation directly - no vtable, fully inlinable:
+ *
+ *     class Dog : public AnimalBase<Dog>
+ *
+ * The CRTP Dog and the virtual oops::Dog share one implementation
+ * (DogImpl), and DynamicAnimal<Impl> puts any CRTP animal behind the
+ * virtual oops::Animal interface, so both kinds of call can be compared on
+ * identical code.
+ */
+
+// oops::Dog is the virtual one, hence the namespace
+namespace oops::crtp {
+
+// Compile-time interface (CRTP)
+template <typename Derived>
+class AnimalBase {
+public:
+    // Resolved at compile time - no vtable, fully inlinable
+    void makeSound() {
+        static_cast<Derived&>(*this).makeSoundImpl();
+    }
+
+    long soundCount() const {
+        return static_cast<const Derived&>(*this).soundCountImpl();
+    }
+
+protected:
+    AnimalBase() = default; // Only usable as a base class
+};
+
+// The virtual Dog's implementation behind the static interface. Pass
+// nullptr to count barks without printing them (hot loops).
+class Dog : public AnimalBase<Dog> {
+    friend class AnimalBase<Dog>;
+
+    DogImpl impl;
+
+    void makeSoundImpl() { impl.makeSound(); }
+    long soundCountImpl() const { return impl.soundCount(); }
+
+public:
+    explicit Dog(std::ostream* out = &std::cout) : impl(out) {}
+};
+
+// Adapter: exposes any CRTP animal through the virtual oops::Animal
+// interface, so it can be stored in a vector<unique_ptr<Animal>>
+template <typename Impl>
+class DynamicAnimal final : public Animal {
+    Impl impl;
+
+public:
+    template <typename... Args>
+    explicit DynamicAnimal(Args&&... args) : impl(std::forward<Args>(args)...) {}
+
+    void makeSound() override { impl.makeSound(); }
+
+    Impl& get() { return impl; }
+    const Impl& get() const { return impl; }
+};
+
+// Generic code over the static interface: instantiated once per concrete type
+template <typename Derived>
+void speakTwice(AnimalBase<Derived>& animal) {
+    animal.makeSound();
+    animal.makeSound();
+}
+
+} // namespace oops::crtp
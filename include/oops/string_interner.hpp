@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "config.hpp"
+#include "lock_order.hpp" // CheckedMutex
+
+/**
+ * String Interning
+ *
+ * Datasets repeat the same names over and over; storing a std::string per
+ * object keeps one heap copy per repetition. The interner keeps ONE copy of
+ * each distinct string in an append-only arena and hands out 32-bit ids:
+ *
+ *     oops::InternedString name("John Doe");  // 4 bytes per object
+ *     std::string_view text = name;           // view into the arena
+ *
+ * - Looking up an already-interned string is lock-free: readers probe an
+ *   open-addressing table of atomic slots. Only inserting a NEW string takes
+ *   the mutex.
+ * - Nothing is ever moved or freed while the interner lives, so views and ids
+ *   stay valid for the whole program. Tables replaced by a resize are kept
+ *   (retired) for the same reason: a concurrent reader may still be using one.
+ */
+
+namespace oops {
+
+class OOPS_API StringInterner {
+public:
+    using Id = std::uint32_t;
+
+    // Process-wide interner used by InternedString
+#ifdef OOPS_SHARED
+    static StringInterner& global(); // Defined once, in the oops library
+#else
+    static StringInterner& global() {
+        static StringInterner interner;
+        return interner;
+    }
+#endif
+
+    StringInterner() {
+        table.store(newTable(kInitialSlots), std::memory_order_relaxed);
+        intern(std::string_view()); // Id 0 is always ""
+    }
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    ~StringInterner() {
+        for (auto& segment : segments) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Returns the id of s, adding it if it has not been seen before
+    Id intern(std::string_view s) {
+        std::size_t hash = std::hash<std::string_view>{}(s);
+        Id id;
+        if (find(*table.load(std::memory_order_acquire), s, hash, id)) {
+            return id; // Fast path: no lock
+        }
+
+        std::lock_guard<CheckedMutex<>> lock(mtx);
+        Table* current = table.load(std::memory_order_relaxed);
+        if (find(*current, s, hash, id)) {
+            return id; // Another thread inserted it meanwhile
+        }
+
+        id = Id(count.load(std::memory_order_relaxed));
+        if (id == kMaxStrings) {
+            throw std::length_error("StringInterner: too many distinct strings");
+        }
+        Entry* entry = entrySlot(id, true);
+        entry->data = copyToArena(s);
+        entry->length = s.size();
+        entry->hash = hash;
+
+        if (2 * (std::size_t(id) + 1) > current->mask + 1) {
+            current = grow(*current);
+        }
+        publish(*current, id, hash);
+        count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // Lock-free; id must come from intern()
+    std::string_view view(Id id) const {
+        const Entry* entry = entrySlot(id);
+        return std::string_view(entry->data, entry->length);
+    }
+
+    // Number of distinct strings
+    std::size_t size() const {
+        return count.load(std::memory_order_acquire);
+    }
+
+    // Bytes owned by the interner: arena + id table + hash table
+    std::size_t memoryBytes() const {
+        std::lock_guard<CheckedMutex<>> lock(mtx);
+        std::size_t bytes = arenaBytes;
+        for (std::size_t k = 0; k < kSegments; ++k) {
+            if (segments[k].load(std::memory_order_relaxed) != nullptr) {
+                bytes += segmentSize(k) * sizeof(Entry);
+            }
+        }
+        const Table* current = table.load(std::memory_order_relaxed);
+        return bytes + (current->mask + 1) * sizeof(std::atomic<Id>);
+    }
+
+private:
+    struct Entry {
+        const char* data;
+        std::size_t length;
+        std::size_t hash;
+    };
+
+    // Open addressing, linear probing. Slot value is id + 1; 0 means empty.
+    struct Table {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Id>[]> slots;
+    };
+
+    static constexpr std::size_t kInitialSlots = 1024;
+    static constexpr std::size_t kChunkBytes = 64 * 1024;
+    // Entries live in segments of 1024, 2048, 4096, ... so they never move
+    static constexpr std::size_t kFirstSegment = 1024;
+    static constexpr std::size_t kSegments = 22;
+    static constexpr std::size_t kMaxStrings = kFirstSegment * ((std::size_t(1) << kSegments) - 1);
+
+    static constexpr std::size_t segmentSize(std::size_t k) { return kFirstSegment << k; }
+
+    bool find(const Table& t, std::string_view s, std::size_t hash, Id& id) const {
+        for (std::size_t i = hash & t.mask;; i = (i + 1) & t.mask) {
+            Id slot = t.slots[i].load(std::memory_order_acquire);
+            if (slot == 0) return false;
+            const Entry* entry = entrySlot(slot - 1);
+            if (entry->hash == hash && std::string_view(entry->data, entry->length) == s) {
+                id = slot - 1;
+                return true;
+            }
+        }
+    }
+
+    static void publish(Table& t, Id id, std::size_t hash) {
+        std::size_t i = hash & t.mask;
+        while (t.slots[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & t.mask;
+        }
+        t.slots[i].store(id + 1, std::memory_order_release);
+    }
+
+    Table* newTable(std::size_t slotCount) {
+        auto t = std::make_unique<Table>();
+        t->mask = slotCount - 1;
+        t->slots = std::make_unique<std::atomic<Id>[]>(slotCount);
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            t->slots[i].store(0, std::memory_order_relaxed);
+        }
+        tables.push_back(std::move(t));
+        return tables.back().get();
+    }
+
+    // Called with the mutex held. The old table stays alive for readers.
+    Table* grow(const Table& old) {
+        Table* bigger = newTable(2 * (old.mask + 1));
+        Id n = Id(count.load(std::memory_order_relaxed));
+        for (Id id = 0; id < n; ++id) {
+            publish(*bigger, id, entrySlot(id)->hash);
+        }
+        table.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    Entry* entrySlot(Id id, bool allocate = false) const {
+        std::size_t k = std::bit_width((std::size_t(id) / kFirstSegment) + 1) - 1;
+        std::size_t offset = id - kFirstSegment * ((std::size_t(1) << k) - 1);
+        Entry* segment = segments[k].load(std::memory_order_acquire);
+        if (segment == nullptr && allocate) {
+            segment = new Entry[segmentSize(k)];
+            segments[k].store(segment, std::memory_order_release);
+        }
+        return segment + offset;
+    }
+
+    const char* copyToArena(std::string_view s) {
+        if (s.size() > chunkRemaining) {
+            std::size_t bytes = std::max(kChunkBytes, s.size());
+            chunks.push_back(std::make_unique<char[]>(bytes));
+            chunkNext = chunks.back().get();
+            chunkRemaining = bytes;
+            arenaBytes += bytes;
+        }
+        char* dest = chunkNext;
+        if (!s.empty()) std::memcpy(dest, s.data(), s.size());
+        chunkNext += s.size();
+        chunkRemaining -= s.size();
+        return dest;
+    }
+
+    mutable CheckedMutex<> mtx{"StringInterner"}; // Guards inserts; readers never take it
+    std::atomic<Table*> table{nullptr};
+    std::atomic<std::size_t> count{0};
+    mutable std::atomic<Entry*> segments[kSegments] = {};
+
+    std::vector<std::unique_ptr<Table>> tables; // Current + retired
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* chunkNext = nullptr;
+    std::size_t chunkRemaining = 0;
+    std::size_t arenaBytes = 0;
+};
+
+// 4-byte handle to a string in the global interner. Equal strings have
+// equal ids, so comparison is an integer compare.
+class InternedString {
+public:
+    InternedString() = default; // ""
+
+    explicit InternedString(std::string_view s)
+        : handle(StringInterner::global().intern(s)) {}
+
+    std::string_view view() const { return StringInterner::global().view(handle); }
+    operator std::string_view() const { return view(); }
+
+    StringInterner::Id id() const { return handle; }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.handle == b.handle; }
+
+    friend std::ostream& operator<<(std::ostream& out, InternedString s) {
+        return out << s.view();
+    }
+
+private:
+    StringInterner::Id handle = 0;
+};
+
+} // namespace oops
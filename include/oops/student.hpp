@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+
+#include "instance_counted.hpp" // Tracked<T> (opt-in instance statistics)
+#include "record_schema.hpp"
+#include "result.hpp"
+#include "string_interner.hpp"
+
+namespace oops {
+
+// Encapsulation: data is private, access goes through validating setters.
+// Shared by the Encapsulation demo, StudentTable and the Student loaders.
+class Student : public Tracked<Student> {
+private:
+    // Private attribute (interned: repeated names share one copy)
+    InternedString name;
+    int age = 0;
+
+    // Serialization may read and restore the private fields
+    template <typename> friend struct Schema;
+
+public:
+    // Setter for name (string_view: no temporary std::string)
+    void setName(std::string_view n) {
+        name = InternedString(n);
+    }
+
+    // Getter for name (view into the interner, valid for the whole program)
+    std::string_view getName() const {
+        return name;
+    }
+
+    // Setter for age with validation: an invalid age is reported, not printed
+    Result<> setAge(int a) {
+        if (a <= 0) {
+            return Unexpected(ErrorCode::InvalidAge);
+        }
+        age = a;
+        return {};
+    }
+
+    // Getter for age
+    int getAge() const {
+        return age;
+    }
+};
+
+// Binary layout of Student (see record_file.hpp)
+template <>
+struct Schema<Student> {
+    static constexpr std::string_view name = "Student";
+    static constexpr std::uint32_t version = 1;
+    static constexpr auto fields() {
+        return std::make_tuple(member("name", &Student::name),
+                               member("age", &Student::age));
+    }
+};
+
+} // namespace oops
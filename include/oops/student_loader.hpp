@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include "student.hpp"
+#include "student_table.hpp"
+
+/**
+ * Loading Students from Disk
+ *
+ * The file is memory-mapped, cut into one chunk per thread on newline
+ * boundaries, and each chunk is parsed in parallel. Fields are parsed as
+ * string_views into the mapping (std::from_chars for the age), so no
+ * std::string is created per field; names go straight into the interner.
+ *
+ * CSV:    name,age per line; optional "name,age" header; \n or \r\n endings.
+ *         Fields are not quoted, so names cannot contain commas.
+ * Binary: "OOPSSTU1" | u64 rows | i32 ages[rows] | u32 nameEnd[rows] | names
+ *         (little-endian; name i is names[nameEnd[i-1] .. nameEnd[i]) )
+ *
+ * Rows with an invalid age (see Student::setAge) are counted as rejected,
+ * lines that cannot be parsed as malformed; neither is printed.
+ */
+
+namespace oops {
+
+struct LoadStats {
+    std::size_t rows = 0;      // Rows stored
+    std::size_t rejected = 0;  // Parsed, but the age is invalid
+    std::size_t malformed = 0; // Could not be parsed
+    std::size_t bytes = 0;
+    double seconds = 0.0;
+
+    double rowsPerSecond() const { return seconds > 0 ? double(rows + rejected) / seconds : 0.0; }
+    double megabytesPerSecond() const { return seconds > 0 ? double(bytes) / (1024.0 * 1024.0) / seconds : 0.0; }
+};
+
+class StudentLoader {
+public:
+    explicit StudentLoader(unsigned threads = defaultThreads())
+        : threads(std::max(threads, 1u)) {}
+
+    LoadStats loadCsv(const std::string& path, StudentTable& table) const {
+        return load(path, &StudentLoader::parseCsv, [&](std::vector<Chunk>& chunks, LoadStats& stats) {
+            intoTable(chunks, table, stats);
+        });
+    }
+
+    LoadStats loadCsv(const std::string& path, std::vector<Student>& students) const {
+        return load(path, &StudentLoader::parseCsv, [&](std::vector<Chunk>& chunks, LoadStats& stats) {
+            intoObjects(chunks, students, stats);
+        });
+    }
+
+    LoadStats loadBinary(const std::string& path, StudentTable& table) const {
+        return load(path, &StudentLoader::parseBinary, [&](std::vector<Chunk>& chunks, LoadStats& stats) {
+            intoTable(chunks, table, stats);
+        });
+    }
+
+    LoadStats loadBinary(const std::string& path, std::vector<Student>& students) const {
+        return load(path, &StudentLoader::parseBinary, [&](std::vector<Chunk>& chunks, LoadStats& stats) {
+            intoObjects(chunks, students, stats);
+        });
+    }
+
+    // Writes the table in the binary format read by loadBinary()
+    static void writeBinary(const std::string& path, const StudentTable& table) {
+        // Name offsets are stored as u32: check before creating the file
+        std::uint64_t nameBytes = 0;
+        for (std::size_t i = 0; i < table.size(); ++i) nameBytes += table.name(i).size();
+        if (nameBytes > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("StudentLoader: names exceed the 4 GiB the binary format can address");
+        }
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("StudentLoader: cannot write " + path);
+
+        std::uint64_t rows = table.size();
+        out.write(kMagic, 8);
+        out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+        for (std::size_t i = 0; i < rows; ++i) {
+            std::int32_t age = table.age(i);
+            out.write(reinterpret_cast<const char*>(&age), sizeof(age));
+        }
+        std::uint64_t end = 0;
+        for (std::size_t i = 0; i < rows; ++i) {
+            end += table.name(i).size();
+            std::uint32_t offset = std::uint32_t(end);
+            out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        }
+        for (std::size_t i = 0; i < rows; ++i) {
+            out.write(table.name(i).data(), std::streamsize(table.name(i).size()));
+        }
+    }
+
+private:
+    static constexpr const char* kMagic = "OOPSSTU1";
+
+    // Rows parsed by one thread, still pointing into the mapped file
+    struct Chunk {
+        std::vector<std::string_view> names;
+        std::vector<int> ages;
+        std::size_t malformed = 0;
+    };
+
+    using Parser = void (StudentLoader::*)(std::string_view, std::vector<Chunk>&) const;
+
+    template <typename Store>
+    LoadStats load(const std::string& path, Parser parse, Store store) const {
+        auto start = std::chrono::steady_clock::now();
+        MappedFile file(path);
+        std::vector<Chunk> chunks;
+        (this->*parse)(file.contents(), chunks);
+
+        LoadStats stats;
+        stats.bytes = file.contents().size();
+        for (const Chunk& chunk : chunks) stats.malformed += chunk.malformed;
+        store(chunks, stats); // Must finish before the mapping goes away
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+    void parseCsv(std::string_view text, std::vector<Chunk>& chunks) const {
+        if (text.substr(0, 8) == "name,age") {
+            std::size_t eol = text.find('\n');
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        }
+
+        // Cut into roughly equal pieces, each ending just after a '\n'
+        std::vector<std::string_view> pieces;
+        std::size_t target = text.size() / threads + 1;
+        while (!text.empty()) {
+            std::size_t cut = std::min(text.size(), target);
+            std::size_t eol = text.find('\n', cut == 0 ? 0 : cut - 1);
+            cut = eol == std::string_view::npos ? text.size() : eol + 1;
+            pieces.push_back(text.substr(0, cut));
+            text.remove_prefix(cut);
+        }
+
+        chunks.resize(pieces.size());
+        parallelFor(pieces.size(), [&](std::size_t i) { parseCsvPiece(pieces[i], chunks[i]); });
+    }
+
+    static void parseCsvPiece(std::string_view text, Chunk& chunk) {
+        while (!text.empty()) {
+            std::size_t eol = text.find('\n');
+            std::string_view line = text.substr(0, eol);
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty()) continue;
+
+            std::size_t comma = line.rfind(',');
+            int age = 0;
+            const char* ageEnd = line.data() + line.size();
+            if (comma == std::string_view::npos ||
+                std::from_chars(line.data() + comma + 1, ageEnd, age).ptr != ageEnd) {
+                ++chunk.malformed;
+                continue;
+            }
+            chunk.names.push_back(line.substr(0, comma));
+            chunk.ages.push_back(age);
+        }
+    }
+
+    void parseBinary(std::string_view data, std::vector<Chunk>& chunks) const {
+        std::uint64_t rows = 0;
+        if (data.size() < 16 || data.substr(0, 8) != kMagic) {
+            throw std::runtime_error("StudentLoader: not a Student binary file");
+        }
+        std::memcpy(&rows, data.data() + 8, sizeof(rows));
+        if (rows > (data.size() - 16) / 8) {
+            throw std::runtime_error("StudentLoader: truncated Student binary file");
+        }
+        const char* ages = data.data() + 16;
+        const char* ends = ages + rows * sizeof(std::int32_t);
+        const char* names = ends + rows * sizeof(std::uint32_t);
+        std::size_t nameBytes = data.size() - std::size_t(names - data.data());
+
+        std::size_t pieces = std::max<std::size_t>(1, std::min<std::size_t>(threads, rows));
+        chunks.resize(pieces);
+        parallelFor(pieces, [&](std::size_t p) {
+            std::size_t begin = rows * p / pieces, end = rows * (p + 1) / pieces;
+            Chunk& chunk = chunks[p];
+            chunk.names.reserve(end - begin);
+            chunk.ages.reserve(end - begin);
+            std::uint32_t start = 0;
+            if (begin > 0) std::memcpy(&start, ends + (begin - 1) * 4, 4);
+            for (std::size_t i = begin; i < end; ++i) {
+                std::int32_t age;
+                std::uint32_t stop;
+                std::memcpy(&age, ages + i * 4, 4);
+                std::memcpy(&stop, ends + i * 4, 4);
+                if (stop < start || stop > nameBytes) {
+                    ++chunk.malformed;
+                    continue;
+                }
+                chunk.names.emplace_back(names + start, stop - start);
+                chunk.ages.push_back(age);
+                start = stop;
+            }
+        });
+    }
+
+    static void intoTable(std::vector<Chunk>& chunks, StudentTable& table, LoadStats& stats) {
+        for (const Chunk& chunk : chunks) {
+            IngestResult result = table.ingest(chunk.names, chunk.ages);
+            stats.rows += result.accepted;
+            stats.rejected += result.rejectedCount;
+        }
+    }
+
+    void intoObjects(std::vector<Chunk>& chunks, std::vector<Student>& students, LoadStats& stats) const {
+        // Validate first (same rule as StudentTable), then fill each chunk's range in parallel
+        std::vector<std::vector<std::uint64_t>> rejected(chunks.size());
+        std::vector<std::size_t> offsets(chunks.size() + 1, students.size());
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            rejected[c] = StudentTable::rejectionBitmap(chunks[c].ages, AgeRange{});
+            std::size_t bad = 0;
+            for (std::uint64_t word : rejected[c]) bad += std::popcount(word);
+            stats.rejected += bad;
+            offsets[c + 1] = offsets[c] + chunks[c].ages.size() - bad;
+        }
+        stats.rows += offsets.back() - offsets.front();
+        students.resize(offsets.back());
+
+        parallelFor(chunks.size(), [&](std::size_t c) {
+            std::size_t out = offsets[c];
+            for (std::size_t i = 0; i < chunks[c].ages.size(); ++i) {
+                if ((rejected[c][i / 64] >> (i % 64)) & 1) continue;
+                students[out].setName(chunks[c].names[i]);
+                (void)students[out].setAge(chunks[c].ages[i]); // Rejected rows were skipped above
+                ++out;
+            }
+        });
+    }
+
+    unsigned threads;
+};
+
+} // namespace oops
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "string_interner.hpp"
+
+/**
+ * StudentTable - columnar storage for many students
+ *
+ * Student validates one object at a time and returns a Result per call.
+ * For bulk loads the table keeps one column per field and validates a whole
+ * batch at once: the age check is a branch-free loop the compiler vectorises,
+ * and the result is a bitmap (1 bit per input row).
+ *
+ *     StudentTable table;
+ *     auto result = table.ingest(names, ages);
+ *     if (result.isRejected(i)) ...   // row i of this batch was not stored
+ */
+
+namespace oops {
+
+// Inclusive range of valid ages. The default matches Student::setAge (age > 0).
+struct AgeRange {
+    int min = 1;
+    int max = std::numeric_limits<int>::max();
+};
+
+// Outcome of one ingest() call. Bit i of `rejected` is set if row i failed.
+struct IngestResult {
+    std::size_t accepted = 0;
+    std::size_t rejectedCount = 0;
+    std::vector<std::uint64_t> rejected;
+
+    bool isRejected(std::size_t row) const {
+        return (rejected[row / 64] >> (row % 64)) & 1;
+    }
+};
+
+class StudentTable {
+public:
+    explicit StudentTable(AgeRange range = {}) : range(validated(range)) {}
+
+    // Validates every row, appends the valid ones, reports the invalid ones
+    IngestResult ingest(std::span<const std::string_view> rowNames, std::span<const int> rowAges) {
+        if (rowNames.size() != rowAges.size()) {
+            throw std::invalid_argument("StudentTable::ingest: column sizes differ");
+        }
+
+        IngestResult result;
+        result.rejected = rejectionBitmap(rowAges, range);
+        for (std::uint64_t word : result.rejected) {
+            result.rejectedCount += std::popcount(word);
+        }
+        result.accepted = rowAges.size() - result.rejectedCount;
+
+        names.reserve(names.size() + result.accepted);
+        ages.reserve(ages.size() + result.accepted);
+        for (std::size_t i = 0; i < rowAges.size(); ++i) {
+            if (!result.isRejected(i)) {
+                names.emplace_back(rowNames[i]);
+                ages.push_back(rowAges[i]);
+            }
+        }
+        return result;
+    }
+
+    std::size_t size() const { return ages.size(); }
+    std::string_view name(std::size_t row) const { return names[row]; }
+    int age(std::size_t row) const { return ages[row]; }
+
+    // Whole columns, for scans
+    std::span<const InternedString> nameColumn() const { return names; }
+    std::span<const int> ageColumn() const { return ages; }
+
+    // One bit per row, set when the age is outside `range`
+    static std::vector<std::uint64_t> rejectionBitmap(std::span<const int> rowAges, AgeRange range) {
+        validated(range);
+        std::vector<std::uint64_t> bits((rowAges.size() + 63) / 64, 0);
+        // min <= a <= max  <=>  unsigned(a - min) <= unsigned(max - min): one compare per lane
+        const unsigned width = unsigned(range.max) - unsigned(range.min);
+        const std::size_t fullWords = rowAges.size() / 64;
+
+        for (std::size_t w = 0; w < fullWords; ++w) {
+            const int* block = rowAges.data() + w * 64;
+            // 1) One 0/1 byte per row: a plain compare loop the compiler vectorises
+            std::uint8_t flags[64];
+            for (unsigned j = 0; j < 64; ++j) {
+                flags[j] = unsigned(block[j]) - unsigned(range.min) > width;
+            }
+            // 2) Pack 8 flag bytes into 8 bits with one multiply (little-endian)
+            std::uint64_t word = 0;
+            for (unsigned j = 0; j < 64; j += 8) {
+                std::uint64_t eight;
+                std::memcpy(&eight, flags + j, 8);
+                word |= ((eight * 0x0102040810204080ULL) >> 56) << j;
+            }
+            bits[w] = word;
+        }
+        for (std::size_t i = fullWords * 64; i < rowAges.size(); ++i) {
+            bits[i / 64] |= std::uint64_t(unsigned(rowAges[i]) - unsigned(range.min) > width) << (i % 64);
+        }
+        return bits;
+    }
+
+private:
+    // With min > max the unsigned width above wraps and almost every age passes
+    static AgeRange validated(AgeRange range) {
+        if (range.min > range.max) throw std::invalid_argument("StudentTable: AgeRange min > max");
+        return range;
+    }
+
+    AgeRange range;
+    std::vector<InternedString> names;
+    std::vector<int> ages;
+};
+
+} // namespace oops
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+
+/**
+ * ThreadPool - a work-stealing scheduler
+ *
+ * Starting a std::thread costs tens of microseconds; the pool starts its
+ * workers once and hands them tasks instead.
+ *
+ *     oops::TaskGroup group;                  // Runs on ThreadPool::global()
+ *     group.run([&] { left.sort(); });
+ *     group.run([&] { right.sort(); });
+ *     group.wait();                           // Helps, then rethrows the first exception
+ *
+ *     oops::ThreadPool::global().parallelFor(0, n, 1024, [&](std::size_t begin, std::size_t end) {
+ *         for (std::size_t i = begin; i < end; ++i) out[i] = f(in[i]);
+ *     });
+ *
+ * Each worker owns a Chase-Lev deque: it pushes and pops its own tasks at
+ * the bottom (newest first, while their data is still in cache) and idle
+ * workers steal from the top of someone else's (oldest first: the biggest
+ * pieces of a recursively split range). Tasks submitted from outside the
+ * pool go to a shared queue. Workers with nothing to do spin briefly, then
+ * park on a futex until a task is pushed. A thread waiting for a TaskGroup
+ * runs queued tasks meanwhile, so groups can nest without deadlocking.
+ */
+
+namespace oops {
+
+// hardware_concurrency() is not free, and may report 0
+inline unsigned defaultThreads() {
+    static const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    return threads;
+}
+
+class TaskGroup;
+
+// A unit of work. Heap-allocated; the thread that runs it deletes it.
+struct Job {
+    virtual ~Job() = default;
+    virtual void run() = 0;
+
+    TaskGroup* group = nullptr;
+};
+
+// Chase-Lev deque, in the C11 formulation of Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+// push() and pop() are for the owning thread only; steal() for any thread.
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 256) : ring(new Ring(capacity)) {}
+    ~WorkStealingDeque() { delete ring.load(std::memory_order_relaxed); }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void push(Job* job) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        Ring* r = ring.load(std::memory_order_relaxed);
+        if (b - t > std::int64_t(r->mask)) r = grow(r, t, b);
+        r->put(b, job);
+        bottom.store(b + 1, std::memory_order_release); // Publishes the job to thieves
+    }
+
+    // Newest job, or nullptr if empty
+    Job* pop() {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) { // Empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Job* job = r->get(b);
+        if (t == b) { // Last job: thieves may be after it too
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // Oldest job, or nullptr if empty or another thread got it first
+    Job* steal() {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Job* job = ring.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return job;
+    }
+
+private:
+    struct Ring {
+        explicit Ring(std::size_t capacity) : mask(capacity - 1), slots(new std::atomic<Job*>[capacity]) {}
+
+        Job* get(std::int64_t i) const { return slots[std::size_t(i) & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, Job* job) { slots[std::size_t(i) & mask].store(job, std::memory_order_relaxed); }
+
+        std::size_t mask; // Capacity - 1 (a power of two)
+        std::unique_ptr<std::atomic<Job*>[]> slots;
+    };
+
+    Ring* grow(Ring* old, std::int64_t t, std::int64_t b) {
+        auto* bigger = new Ring(2 * (old->mask + 1));
+        for (std::int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        retired.emplace_back(old); // A thief may still be reading it; freed with the deque
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    alignas(64) std::atomic<Ring*> ring;
+    std::vector<std::unique_ptr<Ring>> retired;
+};
+
+class OOPS_API ThreadPool {
+public:
+    // The caller of TaskGroup::wait() works too, hence one worker fewer than CPUs
+    explicit ThreadPool(unsigned workers = std::max(1u, defaultThreads() - 1)) {
+        for (unsigned i = 0; i < workers; ++i) {
+            this->workers.push_back(std::make_unique<Worker>());
+        }
+        for (unsigned i = 0; i < workers; ++i) {
+            this->workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        stopping.store(true, std::memory_order_seq_cst);
+        wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+        wakeEpoch.notify_all();
+        for (auto& worker : workers) worker->thread.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // The process-wide pool, started on first use
+#ifdef OOPS_SHARED
+    static ThreadPool& global(); // Defined once, in the oops library
+#else
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+#endif
+
+    unsigned size() const { return unsigned(workers.size()); }
+
+    // Index of the calling thread among this pool's workers, or -1
+    int currentWorker() const {
+        const Current& c = current();
+        return c.pool == this ? c.index : -1;
+    }
+
+    // Runs fn(begin', end') over [begin, end) in pieces of at most `grain`
+    // elements. The range is halved recursively and idle workers steal the
+    // halves, so uneven work per element balances itself.
+    template <typename Fn>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn fn);
+
+private:
+    friend class TaskGroup;
+
+    struct alignas(64) Worker {
+        WorkStealingDeque deque;
+        std::thread thread;
+    };
+
+    // Which pool and worker the calling thread belongs to. A static local
+    // of an exported class, so there is one per thread across the library
+    // and the programs.
+    struct Current {
+        const ThreadPool* pool = nullptr;
+        int index = -1;
+        std::uint32_t random = 0x9E3779B9u; // Victim selection
+    };
+
+    static Current& current() {
+        thread_local Current c;
+        return c;
+    }
+
+    void push(Job* job) {
+        Current& c = current();
+        if (c.pool == this) {
+            workers[std::size_t(c.index)]->deque.push(job);
+        } else {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            injected.push_back(job);
+            injectedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Pairs with the fence in park(): either the parking worker sees the
+        // job, or we see it parked and wake it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) {
+            wakeEpoch.fetch_add(1, std::memory_order_relaxed);
+            wakeEpoch.notify_one();
+        }
+    }
+
+    // Own deque first, then the shared queue, then a random victim
+    Job* findJob(int self) {
+        if (self >= 0) {
+            if (Job* job = workers[std::size_t(self)]->deque.pop()) return job;
+        }
+        if (injectedCount.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            if (!injected.empty()) {
+                Job* job = injected.front();
+                injected.pop_front();
+                injectedCount.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        const std::size_t n = workers.size();
+        std::uint32_t& x = current().random; // xorshift32
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        for (std::size_t i = 0, victim = x % n; i < n; ++i, victim = victim + 1 == n ? 0 : victim + 1) {
+            if (int(victim) == self) continue;
+            if (Job* job = workers[victim]->deque.steal()) return job;
+        }
+        return nullptr;
+    }
+
+    void execute(Job* job);
+
+    void workerLoop(unsigned index) {
+        Current& c = current();
+        c.pool = this;
+        c.index = int(index);
+        c.random += index * 0x6D2B79F5u;
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (Job* job = findJob(int(index))) {
+                execute(job);
+            } else {
+                park(int(index));
+            }
+        }
+    }
+
+    void park(int self) {
+        // Fine-grained work often arrives within microseconds: spin first
+        for (int spin = 0; spin < 64; ++spin) {
+            if (Job* job = findJob(self)) return execute(job);
+            std::this_thread::yield();
+        }
+        std::uint32_t epoch = wakeEpoch.load(std::memory_order_seq_cst);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        Job* job = findJob(self);
+        if (!job && !stopping.load(std::memory_order_seq_cst)) {
+            wakeEpoch.wait(epoch, std::memory_order_seq_cst); // Returns once push() bumps the epoch
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (job) execute(job);
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex injectMutex; // Tasks from threads outside the pool
+    std::deque<Job*> injected;
+    std::atomic<std::size_t> injectedCount{0};
+
+    alignas(64) std::atomic<unsigned> sleepers{0};
+    std::atomic<std::uint32_t> wakeEpoch{0}; // Futex parked workers wait on
+    alignas(64) std::atomic<std::uint32_t> doneEpoch{0}; // Bumped when a TaskGroup empties
+    std::atomic<bool> stopping{false};
+};
+
+// A set of tasks to wait for. run() may be called from any thread,
+// including from inside the group's own tasks.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global()) : pool(pool) {}
+
+    // Waits for the tasks still running; an exception is lost here, so call
+    // wait() to see it
+    ~TaskGroup() { join(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename Fn>
+    void run(Fn&& fn) {
+        struct FnJob : Job {
+            explicit FnJob(Fn&& f) : fn(std::forward<Fn>(f)) {}
+            void run() override { fn(); }
+            std::decay_t<Fn> fn;
+        };
+        Job* job = new FnJob(std::forward<Fn>(fn));
+        job->group = this;
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.push(job);
+    }
+
+    // Runs queued tasks until every task of the group has finished, then
+    // rethrows the first exception one of them threw
+    void wait() {
+        join();
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            e = std::exchange(error, nullptr);
+        }
+        if (e) std::rethrow_exception(e);
+    }
+
+private:
+    friend class ThreadPool;
+
+    void join() {
+        const int self = pool.currentWorker();
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (Job* job = pool.findJob(self)) {
+                pool.execute(job);
+                continue;
+            }
+            // Nothing queued: the rest is running on other threads
+            std::uint32_t epoch = pool.doneEpoch.load(std::memory_order_seq_cst);
+            if (pending.load(std::memory_order_seq_cst) == 0) break;
+            pool.doneEpoch.wait(epoch, std::memory_order_seq_cst);
+        }
+    }
+
+    void fail(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) error = std::move(e);
+    }
+
+    ThreadPool& pool;
+    std::atomic<std::size_t> pending{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+inline void ThreadPool::execute(Job* job) {
+    TaskGroup* group = job->group;
+    try {
+        job->run();
+    } catch (...) {
+        group->fail(std::current_exception());
+    }
+    delete job;
+    // Once pending reaches 0 the group may be destroyed: touch only the pool
+    if (group->pending.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+        doneEpoch.fetch_add(1, std::memory_order_seq_cst);
+        doneEpoch.notify_all();
+    }
+}
+
+namespace detail {
+
+// Lazy binary splitting: hand the upper half to thieves, keep halving the lower one
+template <typename Fn>
+void splitRange(TaskGroup& group, std::size_t begin, std::size_t end, std::size_t grain, const Fn& fn) {
+    while (end - begin > grain) {
+        std::size_t mid = begin + (end - begin) / 2;
+        group.run([&group, mid, end, grain, &fn] { splitRange(group, mid, end, grain, fn); });
+        end = mid;
+    }
+    fn(begin, end);
+}
+
+} // namespace detail
+
+template <typename Fn>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn fn) {
+    if (begin >= end) return;
+    TaskGroup group(*this);
+    detail::splitRange(group, begin, end, std::max<std::size_t>(grain, 1), fn);
+    group.wait();
+}
+
+} // namespace oops
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "flat_combining.hpp"
+#include "lock_order.hpp" // CheckedMutex
+#include "locks.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * Thread Safety: three counters
+ *
+ * The same count++ done three ways, plus LockedCounter to try the other
+ * locks of locks.hpp and two counters for heavy contention (sharded, flat
+ * combining); see "Concurrency & Thread Safety".
+ */
+
+namespace oops {
+
+// 1. Unsafe Counter (Race Condition)
+class UnsafeCounter {
+public:
+    int count = 0;
+    void increment() {
+        count++; // Read-Modify-Write is not atomic
+    }
+};
+
+// 2. Safe Counter using Mutex
+class SafeCounterOnlyMutex {
+public:
+    int count = 0;
+    CheckedMutex<> mtx{"SafeCounterOnlyMutex"}; // A std::mutex, lock-order checked with OOPS_CHECK_LOCK_ORDER
+
+    void increment() {
+        // lock_guard automatically locks when created and unlocks when destroyed (RAII)
+        std::lock_guard<CheckedMutex<>> lock(mtx);
+        count++;
+    }
+};
+
+// 3. Safe Counter using Atomics
+class SafeCounterAtomic {
+public:
+    std::atomic<int> count{0};
+
+    void increment() {
+        count++; // Atomic operation
+    }
+};
+
+// 4. Safe Counter with any Lockable (TicketLock, McsLock, ...)
+template <Lockable Lock>
+class LockedCounter {
+public:
+    int count = 0;
+    CheckedMutex<Lock> mtx{"LockedCounter"};
+
+    void increment() {
+        std::lock_guard<CheckedMutex<Lock>> lock(mtx);
+        count++;
+    }
+};
+
+// 5. Sharded Counter: threads increment different cache lines, reads add
+// them up. Increments never contend (unless threads share a shard), reads
+// cost a pass over every shard.
+class SafeCounterSharded {
+public:
+    void increment() {
+        shards[detail::threadIndex() % kShards].count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int value() const {
+        int total = 0;
+        for (const Shard& shard : shards) total += shard.count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    static constexpr std::size_t kShards = 64;
+
+    struct alignas(64) Shard {
+        std::atomic<int> count{0};
+    };
+
+    std::array<Shard, kShards> shards;
+};
+
+// 6. Flat-combining Counter: one thread applies everyone's pending
+// increments in a batch (see flat_combining.hpp). Reads are exact.
+class SafeCounterCombining {
+public:
+    void increment() {
+        count.apply([](int& c) { c++; });
+    }
+
+    int value() {
+        return count.apply([](int& c) { return c; });
+    }
+
+private:
+    FlatCombining<int> count;
+};
+
+// Two threads, each calling counter.increment() `perThread` times. Real
+// threads on purpose, for the race demo: pool tasks may both run on one
+// worker, one after the other, and then UnsafeCounter would never show its
+// race. The safe counters use incrementFromTwoTasks.
+template <typename Counter>
+void incrementFromTwoThreads(Counter& counter, int perThread = 1000) {
+    auto task = [&counter, perThread]() {
+        for (int i = 0; i < perThread; ++i) {
+            counter.increment();
+        }
+    };
+
+    std::thread t1(task);
+    std::thread t2(task);
+
+    t1.join();
+    t2.join();
+}
+
+// Two tasks, each calling counter.increment() `perTask` times, on the
+// thread pool's workers (and the caller): no thread started per call
+template <typename Counter>
+void incrementFromTwoTasks(Counter& counter, int perTask = 1000, ThreadPool& pool = ThreadPool::global()) {
+    auto task = [&counter, perTask]() {
+        for (int i = 0; i < perTask; ++i) {
+            counter.increment();
+        }
+    };
+
+    TaskGroup group(pool);
+    group.run(task);
+    group.run(task);
+    group.wait();
+}
+
+inline void runThreadsUnsafe(UnsafeCounter& counter) {
+    incrementFromTwoThreads(counter);
+}
+
+inline void runThreadsSafe(SafeCounterOnlyMutex& counter) {
+    incrementFromTwoTasks(counter);
+}
+
+inline void runThreadsAtomic(SafeCounterAtomic& counter) {
+    incrementFromTwoTasks(counter);
+}
+
+} // namespace oops
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace oops {
+
+// Human-readable class name for reports ("Dog" rather than "3Dog")
+inline std::string demangle(const std::type_info& type) {
+#if defined(__GNUG__)
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> name(
+        abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+    if (status == 0) return name.get();
+#endif
+    return type.name();
+}
+
+} // namespace oops
@@ -0,0 +1,71 @@
+// The oops shared library.
+//
+// Holds the one instance of each process-wide singleton (see config.hpp) and
+// includes every public header, so a header that does not compile on its
+// own breaks the build. allocation_counter.hpp is left out on purpose: it
+// replaces the global operator new and is meant for single demo programs.
+
+#include "oops/abstraction.hpp"
+#include "oops/access_modifiers.hpp"
+#include "oops/array_expr.hpp"
+#include "oops/bank_account.hpp"
+#include "oops/calculator.hpp"
+#include "oops/car.hpp"
+#include "oops/car_index.hpp"
+#include "oops/car_store.hpp"
+#include "oops/config.hpp"
+#include "oops/dispatch_profiler.hpp"
+#include "oops/flat_combining.hpp"
+#include "oops/inheritance.hpp"
+#include "oops/instance_counted.hpp"
+#include "oops/keywords.hpp"
+#include "oops/lock_order.hpp"
+#include "oops/locks.hpp"
+#include "oops/mapped_file.hpp"
+#include "oops/parallel.hpp"
+#include "oops/perf_scope.hpp"
+#include "oops/pipeline.hpp"
+#include "oops/polymorphism.hpp"
+#include "oops/queues.hpp"
+#include "oops/record_file.hpp"
+#include "oops/record_schema.hpp"
+#include "oops/relationships.hpp"
+#include "oops/resource.hpp"
+#include "oops/result.hpp"
+#include "oops/static_polymorphism.hpp"
+#include "oops/string_interner.hpp"
+#include "oops/student.hpp"
+#include "oops/student_loader.hpp"
+#include "oops/student_table.hpp"
+#include "oops/thread_pool.hpp"
+#include "oops/thread_safety.hpp"
+#include "oops/type_name.hpp"
+
+namespace oops {
+
+StringInterner& StringInterner::global() {
+    static StringInterner interner;
+    return interner;
+}
+
+InstanceRegistry& InstanceRegistry::instance() {
+    static InstanceRegistry registry;
+    return registry;
+}
+
+DispatchProfiler& DispatchProfiler::instance() {
+    static DispatchProfiler profiler;
+    return profiler;
+}
+
+LockOrderGraph& LockOrderGraph::instance() {
+    static LockOrderGraph graph;
+    return graph;
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+} // namespace oops
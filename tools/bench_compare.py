@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""
+Compares two Google Benchmark JSON files (oops_benchmarks output) and fails
+when a benchmark got slower.
+
+Usage: tools/bench_compare.py BASELINE.json CONTENDER.json [options]
+
+Both files should come from runs with --benchmark_repetitions=N (N >= 5,
+10 or more recommended). For every benchmark present in both, the
+repetitions are compared with a two-sided Mann-Whitney U test. A benchmark
+is a regression when its median time grew by more than --threshold AND the
+difference is significant (p < --alpha); only benchmarks matching --gate
+can fail the run, the others are reported.
+
+Exit status: 0 no regression, 1 regression, 2 bad input (including a gated
+benchmark with too few repetitions to test).
+Standard library only.
+"""
+
+import argparse
+import json
+import math
+import re
+import statistics
+import sys
+
+TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_samples(path, metric):
+    """Returns {benchmark name: [time in ns per repetition]}."""
+    try:
+        with open(path) as f:
+            data = json.load(f)
+    except (OSError, ValueError) as e:
+        sys.exit(f"bench_compare: cannot read {path}: {e}")
+
+    samples = {}
+    for b in data.get("benchmarks", []):
+        if b.get("run_type", "iteration") != "iteration" or b.get("error_occurred"):
+            continue  # Aggregates (mean, median, ...) are recomputed here
+        name = b["name"]
+        field = metric
+        if metric == "auto":
+            # UseRealTime() benchmarks (the threaded ones) are judged on wall time
+            field = "real_time" if "/real_time" in name else "cpu_time"
+        samples.setdefault(name, []).append(b[field] * TO_NS[b.get("time_unit", "ns")])
+    return samples
+
+
+def exact_u_cdf(n1, n2):
+    """Null distribution of U without ties: cdf[u] = P(U <= u)."""
+    # counts[i][j][u]: arrangements of i + j values with statistic u
+    counts = [[None] * (n2 + 1) for _ in range(n1 + 1)]
+    for i in range(n1 + 1):
+        for j in range(n2 + 1):
+            if i == 0 or j == 0:
+                counts[i][j] = [1]
+                continue
+            # Largest value from sample 1 (beats all j of sample 2) or from sample 2
+            a = [0] * j + counts[i - 1][j]
+            b = counts[i][j - 1]
+            size = max(len(a), len(b))
+            counts[i][j] = [(a[u] if u < len(a) else 0) + (b[u] if u < len(b) else 0) for u in range(size)]
+    dist = counts[n1][n2]
+    total = sum(dist)
+    cdf, running = [], 0
+    for c in dist:
+        running += c
+        cdf.append(running / total)
+    return cdf
+
+
+def mann_whitney(a, b):
+    """Two-sided p-value of the Mann-Whitney U test for samples a and b."""
+    n1, n2 = len(a), len(b)
+    values = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    n = n1 + n2
+
+    # Average ranks for ties, and the tie correction term
+    rank_sum, tie_term, i = 0.0, 0.0, 0
+    while i < n:
+        j = i
+        while j + 1 < n and values[j + 1][0] == values[i][0]:
+            j += 1
+        rank = (i + j) / 2 + 1
+        rank_sum += rank * sum(1 for k in range(i, j + 1) if values[k][1] == 0)
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+
+    u = rank_sum - n1 * (n1 + 1) / 2
+    if tie_term == 0 and n <= 40:
+        cdf = exact_u_cdf(n1, n2)
+        lower = cdf[int(u)]
+        upper = 1.0 - (cdf[int(u) - 1] if u >= 1 else 0.0)
+        return min(1.0, 2 * min(lower, upper))
+
+    mean = n1 * n2 / 2
+    sigma = math.sqrt(n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1))))
+    if sigma == 0:
+        return 1.0
+    z = max(abs(u - mean) - 0.5, 0.0) / sigma  # Continuity correction
+    return math.erfc(z / math.sqrt(2))
+
+
+def format_time(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return f"{ns / scale:.3g} {unit}"
+    return f"{ns:.3g} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two oops_benchmarks JSON files.")
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown of the median that counts (default 0.05 = 5%%)")
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level (default 0.05)")
+    parser.add_argument("--gate", default=".", help="regex: benchmarks that may fail the run (default: all)")
+    parser.add_argument("--filter", default=".", help="regex: benchmarks to compare (default: all)")
+    parser.add_argument("--metric", choices=("auto", "real_time", "cpu_time"), default="auto")
+    parser.add_argument("--min-repetitions", type=int, default=5)
+    args = parser.parse_args()
+
+    old = load_samples(args.baseline, args.metric)
+    new = load_samples(args.contender, args.metric)
+    names = [name for name in old if name in new and re.search(args.filter, name)]
+    if not names:
+        print("bench_compare: no benchmark in common", file=sys.stderr)
+        return 2
+
+    gate = re.compile(args.gate)
+    width = max(len("Benchmark"), *(len(name) for name in names))
+    print(f"{'Benchmark':<{width}}  {'baseline':>10}  {'contender':>10}  {'change':>8}  {'p-value':>8}  verdict")
+
+    regressions, too_few = [], []
+    for name in names:
+        a, b = old[name], new[name]
+        before, after = statistics.median(a), statistics.median(b)
+        change = after / before - 1 if before > 0 else 0.0
+
+        if min(len(a), len(b)) < args.min_repetitions:
+            p, verdict = float("nan"), "too few repetitions"
+            if gate.search(name):
+                too_few.append(name)
+        else:
+            p = mann_whitney(a, b)
+            if p >= args.alpha or abs(change) <= args.threshold:
+                verdict = "same"
+            elif change > 0:
+                verdict = "REGRESSION" if gate.search(name) else "slower (not gated)"
+                if gate.search(name):
+                    regressions.append((name, before, after, change, p))
+            else:
+                verdict = "faster"
+        print(f"{name:<{width}}  {format_time(before):>10}  {format_time(after):>10}  "
+              f"{change:>+8.1%}  {p:>8.4f}  {verdict}")
+
+    for name in sorted(set(old) - set(new)):
+        print(f"{name}: only in baseline")
+    for name in sorted(set(new) - set(old)):
+        print(f"{name}: only in contender")
+
+    print()
+    if too_few:
+        print(f"{len(too_few)} gated benchmark(s) had fewer than {args.min_repetitions} repetitions and could not "
+              f"be tested (run with --benchmark_repetitions=10).")
+    if regressions:
+        print(f"{len(regressions)} regression(s) beyond {args.threshold:.0%} (p < {args.alpha}):")
+        for name, before, after, change, p in regressions:
+            print(f"  {name}: {format_time(before)} -> {format_time(after)} ({change:+.1%}, p = {p:.4f})")
+        return 1
+    if too_few:
+        return 2  # An untested gate must not pass
+    print(f"No regression beyond {args.threshold:.0%} (p < {args.alpha}).")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
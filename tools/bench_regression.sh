@@ -0,0 +1,126 @@
+#!/usr/bin/env bash
+#
+# Perf-regression gate: builds the benchmark suite for two revisions, runs
+# both on this machine and compares them with tools/bench_compare.py
+# (Mann-Whitney U test over the repetitions of every benchmark).
+#
+# Usage: tools/bench_regression.sh [options] [BASE [CONTENDER]] [-- compare options]
+#   BASE          git revision to compare against (default: HEAD)
+#   CONTENDER     git revision to test (default: the working tree)
+#   --repetitions N   repetitions per benchmark (default 10)
+#   --blocks B        split them into B blocks, alternating the two builds
+#                     (default 5)
+#   --filter REGEX    only run matching benchmarks (default: all)
+#   compare options   passed to bench_compare.py, e.g.
+#                     -- --threshold 0.03 --gate 'Counter|Withdraw'
+#
+# Both builds use the perf configuration (-O3 -march=native). The two
+# binaries take turns, one block of repetitions each (ABBA order), so drift
+# during the run (heat, other load) hits both sides alike instead of looking
+# like a change. The JSON results and run logs are kept in
+# build/bench-regression/. Exits 1 and lists the regressions when a gated
+# benchmark got slower.
+
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+RESULTS="$ROOT/build/bench-regression"
+REPETITIONS=10
+BLOCKS=5
+FILTER="."
+REVS=()
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --repetitions) REPETITIONS="$2"; shift 2 ;;
+        --blocks) BLOCKS="$2"; shift 2 ;;
+        --filter) FILTER="$2"; shift 2 ;;
+        --) shift; break ;;
+        -h|--help) sed -n '2,23p' "${BASH_SOURCE[0]}" | sed 's/^# \{0,1\}//'; exit 0 ;;
+        *) REVS+=("$1"); shift ;;
+    esac
+done
+BASE="${REVS[0]:-HEAD}"
+CONTENDER="${REVS[1]:-}"
+
+OUT="$(mktemp -d)"
+WORKTREES=()
+cleanup() {
+    for tree in "${WORKTREES[@]}"; do
+        git -C "$ROOT" worktree remove --force "$tree" >/dev/null 2>&1 || true
+    done
+    rm -rf "$OUT"
+}
+trap cleanup EXIT
+
+# build <name> <revision or empty for the working tree>: sets BIN
+build() {
+    local name="$1" rev="$2" src="$ROOT"
+    if [[ -n "$rev" ]]; then
+        src="$OUT/src-$name"
+        git -C "$ROOT" worktree add --detach --quiet "$src" "$rev"
+        WORKTREES+=("$src")
+    fi
+    if [[ ! -f "$src/benchmarks/CMakeLists.txt" ]]; then
+        echo "bench_regression: ${rev:-working tree} has no benchmarks/" >&2
+        exit 2
+    fi
+    cmake -S "$src" -B "$OUT/build-$name" -DCMAKE_BUILD_TYPE=Release -DOOPS_NATIVE=ON >/dev/null
+    cmake --build "$OUT/build-$name" --target oops_benchmarks -j"$(nproc)" >/dev/null
+    BIN="$OUT/build-$name/benchmarks/oops_benchmarks"
+}
+
+# run <name> <binary> <block>: one block of repetitions
+run() {
+    local name="$1" bin="$2" block="$3"
+    # Random interleaving spreads each benchmark's repetitions over the block,
+    # so slow drift does not land on one benchmark either
+    "$bin" --benchmark_filter="$FILTER" \
+        --benchmark_repetitions="$PER_BLOCK" \
+        --benchmark_enable_random_interleaving=true \
+        --benchmark_out="$OUT/$name.$block.json" --benchmark_out_format=json \
+        >/dev/null 2>>"$RESULTS/$name.log" || { cat "$RESULTS/$name.log" >&2; exit 2; }
+}
+
+# merge <name>: the repetitions of every block in one JSON file
+merge() {
+    python3 - "$RESULTS/$1.json" "$OUT/$1".*.json <<'MERGE'
+import json
+import sys
+
+merged = None
+for path in sys.argv[2:]:
+    with open(path) as f:
+        data = json.load(f)
+    if merged is None:
+        merged = data
+    else:
+        merged["benchmarks"] += data["benchmarks"]
+with open(sys.argv[1], "w") as f:
+    json.dump(merged, f, indent=1)
+MERGE
+}
+
+mkdir -p "$RESULTS"
+echo "Building baseline (${BASE}) and contender (${CONTENDER:-working tree})..." >&2
+build baseline "$BASE"
+base_bin="$BIN"
+build contender "$CONTENDER"
+contender_bin="$BIN"
+
+PER_BLOCK=$(( (REPETITIONS + BLOCKS - 1) / BLOCKS ))
+: >"$RESULTS/baseline.log"
+: >"$RESULTS/contender.log"
+for ((block = 1; block <= BLOCKS; block++)); do
+    echo "Running block $block/$BLOCKS ($PER_BLOCK repetitions per build)..." >&2
+    if (( block % 2 )); then
+        run baseline "$base_bin" "$block"
+        run contender "$contender_bin" "$block"
+    else
+        run contender "$contender_bin" "$block"
+        run baseline "$base_bin" "$block"
+    fi
+done
+merge baseline
+merge contender
+
+python3 "$ROOT/tools/bench_compare.py" "$RESULTS/baseline.json" "$RESULTS/contender.json" "$@"
@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+#
+# Checks that calls through the sealed (final) leaf classes compile to direct
+# calls: the hot-path functions below must not contain an indirect call/jmp.
+#
+# Usage: tools/check_devirtualization.sh [--lto]
+#   (default)  -O2, one object file per demo
+#   --lto      -O2 -flto with whole-program devirtualisation, linked program
+#
+# Exits non-zero and prints the offending disassembly on failure.
+
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+CXX="${CXX:-g++}"
+OUT="$(mktemp -d)"
+trap 'rm -rf "$OUT"' EXIT
+
+# -fno-inline keeps each hot-path function out of line with only its own call
+# inside; inlined iostream code would otherwise add unrelated indirect calls.
+MODE="O2"
+FLAGS=(-std=c++20 -O2 -fno-inline)
+if [[ "${1:-}" == "--lto" ]]; then
+    MODE="LTO"
+    FLAGS+=(-flto -fdevirtualize-at-ltrans)
+fi
+
+# source file | hot-path function (demangled)
+CHECKS=(
+    "Polymorphism/Polymorphism.cpp|oops::makeSoundDirect(oops::Dog&)"
+    "Abstraction/Abstraction.cpp|oops::drawCircle(oops::Circle&)"
+)
+
+status=0
+for check in "${CHECKS[@]}"; do
+    src="${check%%|*}"
+    func="${check#*|}"
+    bin="$OUT/$(basename "$src" .cpp)"
+
+    if [[ "$MODE" == "LTO" ]]; then
+        "$CXX" "${FLAGS[@]}" "$ROOT/$src" -o "$bin"
+    else
+        "$CXX" "${FLAGS[@]}" -c "$ROOT/$src" -o "$bin"
+    fi
+
+    objdump -d -C --no-show-raw-insn "$bin" > "$bin.asm"
+    # LTO may emit the function as a clone, e.g. "<oops::makeSoundDirect(oops::Dog&) [clone .constprop.0]>"
+    body="$(awk -v f="<$func" '/^[0-9a-f]+ </ && index($0, f) {on=1; next} on && /^$/ {exit} on' "$bin.asm")"
+
+    if [[ -z "$body" ]]; then
+        echo "[$MODE] $func: not found in $src"
+        status=1
+    elif grep -Eq '(call|jmp)[a-z]*[[:space:]]+\*' <<< "$body"; then
+        echo "[$MODE] $func: INDIRECT call found in $src"
+        echo "$body"
+        status=1
+    else
+        echo "[$MODE] $func: direct"
+    fi
+done
+
+exit $status